@@ -0,0 +1,245 @@
+//
+//  AllocProfile.cpp
+//
+
+#include "AllocProfile.hpp"
+#include <atomic>
+#include <errno.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#ifdef ALLOC_PROFILE_GMP
+#include <gmp.h>
+#endif
+
+// Allocateur de la glibc, appelé directement pour ne pas compter deux fois une
+// allocation (operator new et GMP ne passent pas par le malloc remplacé ci-dessous).
+extern "C"
+{
+    void *__libc_malloc(size_t taille);
+    void *__libc_calloc(size_t nb, size_t taille);
+    void *__libc_realloc(void *ptr, size_t taille);
+    void __libc_free(void *ptr);
+    void *__libc_memalign(size_t alignement, size_t taille);
+}
+
+typedef enum origine_t
+{
+    ORIGINE_NEW,
+    ORIGINE_MALLOC,
+#ifdef ALLOC_PROFILE_GMP
+    ORIGINE_GMP,
+#endif
+    NB_ORIGINES
+} origine_t;
+
+// Compteurs initialisés à zéro statiquement : utilisables avant les constructeurs globaux.
+typedef struct phase_alloc_t
+{
+    std::atomic<uint64_t> nb[NB_ORIGINES];
+    std::atomic<uint64_t> octets[NB_ORIGINES];
+} phase_alloc_t;
+
+static phase_alloc_t gPhases[ALLOC_PROFILE_MAX_PHASES];
+static const char *gNomsPhases[ALLOC_PROFILE_MAX_PHASES] = {"init"};
+static std::atomic<int> gNbPhases(1);
+static std::atomic<int> gPhase(0);
+static std::atomic<bool> gActif(true); //faux pendant l'écriture du rapport
+static pthread_mutex_t gPhasesLock = PTHREAD_MUTEX_INITIALIZER;
+
+static inline void compter(origine_t origine, size_t taille)
+{
+    if (!gActif.load(std::memory_order_relaxed))
+        return;
+    phase_alloc_t &phase = gPhases[gPhase.load(std::memory_order_relaxed)];
+    phase.nb[origine].fetch_add(1, std::memory_order_relaxed);
+    phase.octets[origine].fetch_add(taille, std::memory_order_relaxed);
+}
+
+void alloc_phase(const char *nom)
+{
+    pthread_mutex_lock(&gPhasesLock);
+    int nb = gNbPhases.load(std::memory_order_relaxed);
+    int i = 0;
+    while (i < nb && strcmp(gNomsPhases[i], nom) != 0)
+        i++;
+    if (i == nb && nb < ALLOC_PROFILE_MAX_PHASES)
+    {
+        gNomsPhases[nb] = nom;
+        gNbPhases.store(nb + 1, std::memory_order_relaxed);
+    }
+    if (i < ALLOC_PROFILE_MAX_PHASES)
+        gPhase.store(i, std::memory_order_relaxed);
+    pthread_mutex_unlock(&gPhasesLock);
+}
+
+void alloc_report(void)
+{
+    gActif.store(false);
+#ifdef ALLOC_PROFILE_GMP
+    const char *noms_origines[NB_ORIGINES] = {"new", "malloc", "gmp"};
+#else
+    const char *noms_origines[NB_ORIGINES] = {"new", "malloc"};
+#endif
+    uint64_t total_nb[NB_ORIGINES] = {0}, total_octets[NB_ORIGINES] = {0};
+    fprintf(stderr, "[alloc] %-12s", "phase");
+    for (int o = 0; o < NB_ORIGINES; o++)
+        fprintf(stderr, " %10s(n) %14s", noms_origines[o], "octets");
+    fprintf(stderr, "\n");
+    for (int i = 0; i < gNbPhases.load(); i++)
+    {
+        fprintf(stderr, "[alloc] %-12s", gNomsPhases[i]);
+        for (int o = 0; o < NB_ORIGINES; o++)
+        {
+            uint64_t nb = gPhases[i].nb[o].load(), octets = gPhases[i].octets[o].load();
+            total_nb[o] += nb;
+            total_octets[o] += octets;
+            fprintf(stderr, " %13llu %14llu", (unsigned long long)nb, (unsigned long long)octets);
+        }
+        fprintf(stderr, "\n");
+    }
+    fprintf(stderr, "[alloc] %-12s", "total");
+    for (int o = 0; o < NB_ORIGINES; o++)
+        fprintf(stderr, " %13llu %14llu", (unsigned long long)total_nb[o], (unsigned long long)total_octets[o]);
+    fprintf(stderr, "\n");
+}
+
+#ifdef ALLOC_PROFILE_GMP
+// Fonctions mémoire de GMP
+static void *gmp_alloc(size_t taille)
+{
+    compter(ORIGINE_GMP, taille);
+    void *ptr = __libc_malloc(taille);
+    if (ptr == NULL)
+        abort();
+    return ptr;
+}
+
+static void *gmp_realloc(void *ptr, size_t, size_t taille)
+{
+    compter(ORIGINE_GMP, taille);
+    void *nouveau = __libc_realloc(ptr, taille);
+    if (nouveau == NULL)
+        abort();
+    return nouveau;
+}
+
+static void gmp_free(void *ptr, size_t)
+{
+    __libc_free(ptr);
+}
+#endif
+
+// Avant les constructeurs globaux (Custom_mpz_t statiques...) : tous les mpz passent
+// par gmp_alloc ; le rapport, enregistré en premier, est écrit en dernier.
+__attribute__((constructor(101))) static void alloc_profile_init(void)
+{
+#ifdef ALLOC_PROFILE_GMP
+    mp_set_memory_functions(gmp_alloc, gmp_realloc, gmp_free);
+#endif
+    atexit(alloc_report);
+}
+
+// malloc et compagnie (glibc : les définitions du programme remplacent celles de la libc)
+extern "C"
+{
+    void *malloc(size_t taille)
+    {
+        compter(ORIGINE_MALLOC, taille);
+        return __libc_malloc(taille);
+    }
+
+    void *calloc(size_t nb, size_t taille)
+    {
+        compter(ORIGINE_MALLOC, nb * taille);
+        return __libc_calloc(nb, taille);
+    }
+
+    void *realloc(void *ptr, size_t taille)
+    {
+        compter(ORIGINE_MALLOC, taille);
+        return __libc_realloc(ptr, taille);
+    }
+
+    void free(void *ptr)
+    {
+        __libc_free(ptr);
+    }
+
+    // allocations alignées (posix_memalign : stockage des matrices, tampons de GEMM...)
+    int posix_memalign(void **ptr, size_t alignement, size_t taille)
+    {
+        if (alignement % sizeof(void *) != 0 || (alignement & (alignement - 1)) != 0 || alignement == 0)
+            return EINVAL;
+        compter(ORIGINE_MALLOC, taille);
+        void *resultat = __libc_memalign(alignement, taille);
+        if (resultat == NULL)
+            return ENOMEM;
+        *ptr = resultat;
+        return 0;
+    }
+
+    void *aligned_alloc(size_t alignement, size_t taille)
+    {
+        compter(ORIGINE_MALLOC, taille);
+        return __libc_memalign(alignement, taille);
+    }
+
+    void *memalign(size_t alignement, size_t taille)
+    {
+        compter(ORIGINE_MALLOC, taille);
+        return __libc_memalign(alignement, taille);
+    }
+}
+
+// operator new / delete
+static void *nouveau(size_t taille)
+{
+    compter(ORIGINE_NEW, taille);
+    void *ptr = __libc_malloc(taille ? taille : 1);
+    if (ptr == NULL)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+#ifdef __cpp_aligned_new
+static void *nouveau_aligne(size_t taille, std::align_val_t alignement)
+{
+    compter(ORIGINE_NEW, taille);
+    void *ptr = __libc_memalign((size_t)alignement, taille ? taille : 1);
+    if (ptr == NULL)
+        throw std::bad_alloc();
+    return ptr;
+}
+#endif
+
+void *operator new(size_t taille) { return nouveau(taille); }
+void *operator new[](size_t taille) { return nouveau(taille); }
+void *operator new(size_t taille, std::nothrow_t const &) noexcept
+{
+    compter(ORIGINE_NEW, taille);
+    return __libc_malloc(taille ? taille : 1);
+}
+void *operator new[](size_t taille, std::nothrow_t const &) noexcept
+{
+    compter(ORIGINE_NEW, taille);
+    return __libc_malloc(taille ? taille : 1);
+}
+#ifdef __cpp_aligned_new
+void *operator new(size_t taille, std::align_val_t alignement) { return nouveau_aligne(taille, alignement); }
+void *operator new[](size_t taille, std::align_val_t alignement) { return nouveau_aligne(taille, alignement); }
+#endif
+
+void operator delete(void *ptr) noexcept { __libc_free(ptr); }
+void operator delete[](void *ptr) noexcept { __libc_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { __libc_free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { __libc_free(ptr); }
+#ifdef __cpp_aligned_new
+void operator delete(void *ptr, std::align_val_t) noexcept { __libc_free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { __libc_free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { __libc_free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { __libc_free(ptr); }
+#endif
@@ -0,0 +1,35 @@
+//
+//  AllocProfile.hpp
+//
+
+#ifndef __ALLOCPROFILE_HPP__
+#define __ALLOCPROFILE_HPP__
+
+// Profil des allocations par phase (parse, compute... pour le moteur de nombres premiers,
+// pivot, eliminate, refine, multiply pour l'inversion du Tp3) : nombre d'allocations et
+// octets demandés, séparés selon leur origine (operator new, famille malloc et, si
+// ALLOC_PROFILE_GMP est défini, fonctions mémoire de GMP). Activé seulement si le projet
+// est configuré avec -DENABLE_ALLOC_PROFILE=ON : AllocProfile.cpp remplace alors
+// operator new/delete et malloc, calloc, realloc, free, posix_memalign, aligned_alloc,
+// memalign (glibc), et installe ses fonctions dans GMP (mp_set_memory_functions). Sinon
+// ALLOC_PHASE disparaît à la compilation.
+//
+// La phase courante est globale au processus : elle est fixée par le thread principal
+// entre les étapes, et les allocations des threads de calcul lui sont attribuées.
+// Le rapport est écrit sur stderr à la sortie du programme.
+
+#define ALLOC_PROFILE_MAX_PHASES 32
+
+// Les allocations suivantes sont attribuées à la phase nom (chaîne littérale).
+void alloc_phase(const char *nom);
+
+// Écrire le rapport par phase sur stderr (appelé automatiquement par atexit).
+void alloc_report(void);
+
+#ifdef ENABLE_ALLOC_PROFILE
+#define ALLOC_PHASE(nom) alloc_phase(nom)
+#else
+#define ALLOC_PHASE(nom) ((void)0)
+#endif
+
+#endif
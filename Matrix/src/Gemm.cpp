@@ -0,0 +1,369 @@
+//
+//  Gemm.cpp
+//
+
+#include "Gemm.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Tuile du micro-noyau selon le type des éléments : une rangée de tuile occupe deux
+// registres AVX2 (8 doubles ou 16 floats).
+template <typename T>
+struct GemmTile;
+
+template <>
+struct GemmTile<double>
+{
+    enum { MR = GEMM_MR, NR = GEMM_NR };
+};
+
+template <>
+struct GemmTile<float>
+{
+    enum { MR = GEMM_MR, NR = 2 * GEMM_NR };
+};
+
+// Tampon aligné pour les blocs packés, libéré à la sortie de la portée.
+template <typename T>
+class PackBuffer
+{
+
+  public:
+    PackBuffer(size_t iSize) : mData(NULL)
+    {
+        if (posix_memalign((void **)&mData, MATRIX_ALIGNMENT, iSize * sizeof(T)) != 0)
+            throw bad_alloc();
+    }
+    ~PackBuffer(void) { free(mData); }
+    T *data(void) { return mData; }
+
+  private:
+    PackBuffer(const PackBuffer &);
+    PackBuffer &operator=(const PackBuffer &);
+    T *mData;
+};
+
+// Recopier le bloc iA (mc x kc) par bandes de MR rangées : dans chaque bande,
+// les MR éléments d'une même colonne sont consécutifs. Complété par des zéros.
+template <typename T>
+static void packA(const BasicBlockView<const T> &iA, T *oPacked)
+{
+    const size_t MR = GemmTile<T>::MR;
+    for (size_t i0 = 0; i0 < iA.rows(); i0 += MR)
+    {
+        size_t lRows = (iA.rows() - i0 < MR) ? iA.rows() - i0 : MR;
+        for (size_t k = 0; k < iA.cols(); ++k)
+        {
+            for (size_t i = 0; i < lRows; ++i)
+                oPacked[i] = iA(i0 + i, k);
+            for (size_t i = lRows; i < MR; ++i)
+                oPacked[i] = 0;
+            oPacked += MR;
+        }
+    }
+}
+
+// Recopier la bande de NR colonnes de iB (kc x nc) qui commence à la colonne j0 :
+// les NR éléments d'une même rangée sont consécutifs. Complété par des zéros.
+template <typename T>
+static void packBPanel(const BasicBlockView<const T> &iB, size_t j0, T *oPacked)
+{
+    const size_t NR = GemmTile<T>::NR;
+    size_t lCols = (iB.cols() - j0 < NR) ? iB.cols() - j0 : NR;
+    for (size_t k = 0; k < iB.rows(); ++k)
+    {
+        const T *lRow = &iB(k, j0);
+        for (size_t j = 0; j < lCols; ++j)
+            oPacked[j] = lRow[j];
+        for (size_t j = lCols; j < NR; ++j)
+            oPacked[j] = 0;
+        oPacked += NR;
+    }
+}
+
+// Tuile complète : oC(MR x NR, rangées séparées de iStride) += iAlpha * A * B
+// sur kc colonnes de bandes packées. Boucles portables, remplacées plus bas par les
+// noyaux AVX2 quand ils sont compilés.
+template <typename T>
+static void microKernel(size_t iKc, const T *iA, const T *iB, T iAlpha, T *oC, size_t iStride)
+{
+    const size_t MR = GemmTile<T>::MR, NR = GemmTile<T>::NR;
+    T lC[MR][NR] = {{0}};
+    for (size_t k = 0; k < iKc; ++k)
+    {
+        for (size_t i = 0; i < MR; ++i)
+            for (size_t j = 0; j < NR; ++j)
+                lC[i][j] += iA[i] * iB[j];
+        iA += MR;
+        iB += NR;
+    }
+    for (size_t i = 0; i < MR; ++i)
+        for (size_t j = 0; j < NR; ++j)
+            oC[i * iStride + j] += iAlpha * lC[i][j];
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+template <>
+void microKernel<double>(size_t iKc, const double *iA, const double *iB, double iAlpha, double *oC, size_t iStride)
+{
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for (size_t k = 0; k < iKc; ++k)
+    {
+        __m256d b0 = _mm256_load_pd(iB), b1 = _mm256_load_pd(iB + 4);
+        __m256d a;
+        a = _mm256_broadcast_sd(iA + 0);
+        c00 = _mm256_fmadd_pd(a, b0, c00);
+        c01 = _mm256_fmadd_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(iA + 1);
+        c10 = _mm256_fmadd_pd(a, b0, c10);
+        c11 = _mm256_fmadd_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(iA + 2);
+        c20 = _mm256_fmadd_pd(a, b0, c20);
+        c21 = _mm256_fmadd_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(iA + 3);
+        c30 = _mm256_fmadd_pd(a, b0, c30);
+        c31 = _mm256_fmadd_pd(a, b1, c31);
+        a = _mm256_broadcast_sd(iA + 4);
+        c40 = _mm256_fmadd_pd(a, b0, c40);
+        c41 = _mm256_fmadd_pd(a, b1, c41);
+        a = _mm256_broadcast_sd(iA + 5);
+        c50 = _mm256_fmadd_pd(a, b0, c50);
+        c51 = _mm256_fmadd_pd(a, b1, c51);
+        iA += GEMM_MR;
+        iB += GEMM_NR;
+    }
+    __m256d lAlpha = _mm256_set1_pd(iAlpha);
+    double *lRow = oC;
+    _mm256_storeu_pd(lRow, _mm256_fmadd_pd(lAlpha, c00, _mm256_loadu_pd(lRow)));
+    _mm256_storeu_pd(lRow + 4, _mm256_fmadd_pd(lAlpha, c01, _mm256_loadu_pd(lRow + 4)));
+    lRow += iStride;
+    _mm256_storeu_pd(lRow, _mm256_fmadd_pd(lAlpha, c10, _mm256_loadu_pd(lRow)));
+    _mm256_storeu_pd(lRow + 4, _mm256_fmadd_pd(lAlpha, c11, _mm256_loadu_pd(lRow + 4)));
+    lRow += iStride;
+    _mm256_storeu_pd(lRow, _mm256_fmadd_pd(lAlpha, c20, _mm256_loadu_pd(lRow)));
+    _mm256_storeu_pd(lRow + 4, _mm256_fmadd_pd(lAlpha, c21, _mm256_loadu_pd(lRow + 4)));
+    lRow += iStride;
+    _mm256_storeu_pd(lRow, _mm256_fmadd_pd(lAlpha, c30, _mm256_loadu_pd(lRow)));
+    _mm256_storeu_pd(lRow + 4, _mm256_fmadd_pd(lAlpha, c31, _mm256_loadu_pd(lRow + 4)));
+    lRow += iStride;
+    _mm256_storeu_pd(lRow, _mm256_fmadd_pd(lAlpha, c40, _mm256_loadu_pd(lRow)));
+    _mm256_storeu_pd(lRow + 4, _mm256_fmadd_pd(lAlpha, c41, _mm256_loadu_pd(lRow + 4)));
+    lRow += iStride;
+    _mm256_storeu_pd(lRow, _mm256_fmadd_pd(lAlpha, c50, _mm256_loadu_pd(lRow)));
+    _mm256_storeu_pd(lRow + 4, _mm256_fmadd_pd(lAlpha, c51, _mm256_loadu_pd(lRow + 4)));
+}
+
+// Même noyau en simple précision : tuiles 6 x 16, 8 floats par registre.
+template <>
+void microKernel<float>(size_t iKc, const float *iA, const float *iB, float iAlpha, float *oC, size_t iStride)
+{
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+    for (size_t k = 0; k < iKc; ++k)
+    {
+        __m256 b0 = _mm256_load_ps(iB), b1 = _mm256_load_ps(iB + 8);
+        __m256 a;
+        a = _mm256_broadcast_ss(iA + 0);
+        c00 = _mm256_fmadd_ps(a, b0, c00);
+        c01 = _mm256_fmadd_ps(a, b1, c01);
+        a = _mm256_broadcast_ss(iA + 1);
+        c10 = _mm256_fmadd_ps(a, b0, c10);
+        c11 = _mm256_fmadd_ps(a, b1, c11);
+        a = _mm256_broadcast_ss(iA + 2);
+        c20 = _mm256_fmadd_ps(a, b0, c20);
+        c21 = _mm256_fmadd_ps(a, b1, c21);
+        a = _mm256_broadcast_ss(iA + 3);
+        c30 = _mm256_fmadd_ps(a, b0, c30);
+        c31 = _mm256_fmadd_ps(a, b1, c31);
+        a = _mm256_broadcast_ss(iA + 4);
+        c40 = _mm256_fmadd_ps(a, b0, c40);
+        c41 = _mm256_fmadd_ps(a, b1, c41);
+        a = _mm256_broadcast_ss(iA + 5);
+        c50 = _mm256_fmadd_ps(a, b0, c50);
+        c51 = _mm256_fmadd_ps(a, b1, c51);
+        iA += GEMM_MR;
+        iB += 2 * GEMM_NR;
+    }
+    __m256 lAlpha = _mm256_set1_ps(iAlpha);
+    float *lRow = oC;
+    _mm256_storeu_ps(lRow, _mm256_fmadd_ps(lAlpha, c00, _mm256_loadu_ps(lRow)));
+    _mm256_storeu_ps(lRow + 8, _mm256_fmadd_ps(lAlpha, c01, _mm256_loadu_ps(lRow + 8)));
+    lRow += iStride;
+    _mm256_storeu_ps(lRow, _mm256_fmadd_ps(lAlpha, c10, _mm256_loadu_ps(lRow)));
+    _mm256_storeu_ps(lRow + 8, _mm256_fmadd_ps(lAlpha, c11, _mm256_loadu_ps(lRow + 8)));
+    lRow += iStride;
+    _mm256_storeu_ps(lRow, _mm256_fmadd_ps(lAlpha, c20, _mm256_loadu_ps(lRow)));
+    _mm256_storeu_ps(lRow + 8, _mm256_fmadd_ps(lAlpha, c21, _mm256_loadu_ps(lRow + 8)));
+    lRow += iStride;
+    _mm256_storeu_ps(lRow, _mm256_fmadd_ps(lAlpha, c30, _mm256_loadu_ps(lRow)));
+    _mm256_storeu_ps(lRow + 8, _mm256_fmadd_ps(lAlpha, c31, _mm256_loadu_ps(lRow + 8)));
+    lRow += iStride;
+    _mm256_storeu_ps(lRow, _mm256_fmadd_ps(lAlpha, c40, _mm256_loadu_ps(lRow)));
+    _mm256_storeu_ps(lRow + 8, _mm256_fmadd_ps(lAlpha, c41, _mm256_loadu_ps(lRow + 8)));
+    lRow += iStride;
+    _mm256_storeu_ps(lRow, _mm256_fmadd_ps(lAlpha, c50, _mm256_loadu_ps(lRow)));
+    _mm256_storeu_ps(lRow + 8, _mm256_fmadd_ps(lAlpha, c51, _mm256_loadu_ps(lRow + 8)));
+}
+#endif
+
+// Produit d'un bloc A packé (mc x kc) par un bloc B packé (kc x nc), ajouté à oC.
+template <typename T>
+static void macroKernel(size_t iMc, size_t iNc, size_t iKc, const T *iA, const T *iB,
+                        T iAlpha, const BasicBlockView<T> &oC)
+{
+    const size_t MR = GemmTile<T>::MR, NR = GemmTile<T>::NR;
+    for (size_t j0 = 0; j0 < iNc; j0 += NR)
+    {
+        size_t lCols = (iNc - j0 < NR) ? iNc - j0 : NR;
+        for (size_t i0 = 0; i0 < iMc; i0 += MR)
+        {
+            size_t lRows = (iMc - i0 < MR) ? iMc - i0 : MR;
+            const T *lA = iA + i0 * iKc, *lB = iB + j0 * iKc;
+            if (lRows == MR && lCols == NR)
+                microKernel(iKc, lA, lB, iAlpha, &oC(i0, j0), oC.stride());
+            else
+            {
+                // tuile de bord : calculée dans un tampon, puis seule la partie utile est ajoutée
+                T lTile[MR * NR] = {0};
+                microKernel(iKc, lA, lB, iAlpha, lTile, NR);
+                for (size_t i = 0; i < lRows; ++i)
+                    for (size_t j = 0; j < lCols; ++j)
+                        oC(i0 + i, j0 + j) += lTile[i * NR + j];
+            }
+        }
+    }
+}
+
+// oC = iAlpha * iA * iB + iBeta * oC, par rangées.
+// En parallèle : le bloc packé de B est partagé (chaque thread en packe des bandes), puis
+// les threads se partagent les blocs de GEMM_MC rangées de C, chacun avec son tampon A.
+template <typename T>
+static void multiplyRowMajor(const BasicBlockView<const T> &iA, const BasicBlockView<const T> &iB,
+                             const BasicBlockView<T> &oC, T iAlpha, T iBeta)
+{
+    const size_t MR = GemmTile<T>::MR, NR = GemmTile<T>::NR;
+    // oC = iBeta * oC, puis les produits partiels y sont accumulés
+    parallelFor(0, oC.rows(), [&](size_t i) {
+        // comme en BLAS, iBeta = 0 ignore le contenu de oC (même NaN)
+        if (iBeta == 0)
+            for (size_t j = 0; j < oC.cols(); ++j)
+                oC(i, j) = 0;
+        else if (iBeta != 1)
+            oC.getRow(i) *= iBeta;
+    }, oC.cols());
+    if (iA.cols() == 0 || oC.rows() == 0 || oC.cols() == 0)
+        return;
+
+    // assez de blocs de rangées pour occuper tous les threads
+    int lThreads = getMatrixThreads();
+    if ((double)oC.rows() * oC.cols() * iA.cols() < MATRIX_PARALLEL_MIN_WORK * 16.0)
+        lThreads = 1;
+    size_t lMc = GEMM_MC;
+    if (lThreads > 1)
+    {
+        size_t lPart = ((oC.rows() + lThreads - 1) / lThreads + MR - 1) / MR * MR;
+        lMc = min<size_t>(lMc, lPart);
+    }
+
+    // tampons à la taille des plus grands blocs effectivement utilisés, bandes complètes
+    size_t lMcMax = (min<size_t>(oC.rows(), lMc) + MR - 1) / MR * MR;
+    size_t lNcMax = (min<size_t>(oC.cols(), GEMM_NC) + NR - 1) / NR * NR;
+    size_t lKcMax = min<size_t>(iA.cols(), GEMM_KC);
+    PackBuffer<T> lPackB(lKcMax * lNcMax);
+    long lBlocks = (long)((oC.rows() + lMc - 1) / lMc);
+#pragma omp parallel num_threads(lThreads) if (lThreads > 1)
+    {
+        PackBuffer<T> lPackA(lMcMax * lKcMax);
+        for (size_t j0 = 0; j0 < oC.cols(); j0 += GEMM_NC)
+        {
+            size_t lNc = (oC.cols() - j0 < GEMM_NC) ? oC.cols() - j0 : GEMM_NC;
+            long lPanels = (long)((lNc + NR - 1) / NR);
+            for (size_t k0 = 0; k0 < iA.cols(); k0 += GEMM_KC)
+            {
+                size_t lKc = (iA.cols() - k0 < GEMM_KC) ? iA.cols() - k0 : GEMM_KC;
+                BasicBlockView<const T> lB = iB.getBlock(k0, j0, lKc, lNc);
+#pragma omp for schedule(static)
+                for (long p = 0; p < lPanels; ++p)
+                    packBPanel(lB, p * NR, lPackB.data() + p * NR * lKc);
+                // (barrière implicite : B est packé avant d'être lu)
+#pragma omp for schedule(dynamic)
+                for (long b = 0; b < lBlocks; ++b)
+                {
+                    size_t i0 = b * lMc;
+                    size_t lMcCur = (oC.rows() - i0 < lMc) ? oC.rows() - i0 : lMc;
+                    packA(iA.getBlock(i0, k0, lMcCur, lKc), lPackA.data());
+                    macroKernel(lMcCur, lNc, lKc, lPackA.data(), lPackB.data(), iAlpha, oC.getBlock(i0, j0, lMcCur, lNc));
+                }
+                // (barrière implicite : B n'est pas écrasé pendant qu'il est lu)
+            }
+        }
+    }
+}
+
+// Par rangées : directement.
+template <typename T>
+static void multiplyLayout(const BasicBlockView<const T, RowMajor> &iA, const BasicBlockView<const T, RowMajor> &iB,
+                           const BasicBlockView<T, RowMajor> &oC, T iAlpha, T iBeta)
+{
+    multiplyRowMajor(iA, iB, oC, iAlpha, iBeta);
+}
+
+// Par colonnes : la transposée d'un bloc ColMajor est un bloc RowMajor sur les mêmes
+// données, et C^T = B^T A^T.
+template <typename T>
+static void multiplyLayout(const BasicBlockView<const T, ColMajor> &iA, const BasicBlockView<const T, ColMajor> &iB,
+                           const BasicBlockView<T, ColMajor> &oC, T iAlpha, T iBeta)
+{
+    multiplyRowMajor(iB.transpose(), iA.transpose(), oC.transpose(), iAlpha, iBeta);
+}
+
+// oC = iAlpha * iA * iB + iBeta * oC.
+template <typename T, typename Layout>
+void multiplyBlocks(const typename BasicBlockView<T, Layout>::ConstView &iA,
+                    const typename BasicBlockView<T, Layout>::ConstView &iB, const BasicBlockView<T, Layout> &oC,
+                    typename BasicBlockView<T, Layout>::value_type iAlpha,
+                    typename BasicBlockView<T, Layout>::value_type iBeta)
+{
+    // vérifier la compatibilité des blocs
+    assert(iA.cols() == iB.rows() && iA.rows() == oC.rows() && iB.cols() == oC.cols());
+    multiplyLayout<T>(iA, iB, oC, iAlpha, iBeta);
+}
+
+// Multiplier deux matrices.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> multiplyMatrix(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2)
+{
+    // vérifier la compatibilité des matrices
+    assert(iMat1.cols() == iMat2.rows());
+    // effectuer le produit matriciel
+    BasicMatrix<T, Layout> lRes(iMat1.rows(), iMat2.cols());
+    multiplyBlocks(iMat1.getBlock(), iMat2.getBlock(), lRes.getBlock());
+    return lRes;
+}
+
+// Instanciations compilées dans la bibliothèque.
+#define INSTANTIATE_GEMM(T, Layout)                                                                              \
+    template void multiplyBlocks<T, Layout>(const BasicBlockView<const T, Layout> &, const BasicBlockView<const T, Layout> &, \
+                                            const BasicBlockView<T, Layout> &, T, T);                            \
+    template BasicMatrix<T, Layout> multiplyMatrix(const BasicMatrix<T, Layout> &, const BasicMatrix<T, Layout> &);
+
+INSTANTIATE_GEMM(double, RowMajor)
+INSTANTIATE_GEMM(float, RowMajor)
+INSTANTIATE_GEMM(double, ColMajor)
+INSTANTIATE_GEMM(float, ColMajor)
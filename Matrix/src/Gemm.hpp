@@ -0,0 +1,40 @@
+//
+//  Gemm.hpp
+//
+
+#ifndef __GEMM_HPP__
+#define __GEMM_HPP__
+
+#include "Matrix.hpp"
+
+// Produit matriciel par blocs (à la BLIS) : les blocs de A et de B sont recopiés
+// (« packés ») dans des tampons contigus dimensionnés pour les caches L2 et L3, puis un
+// micro-noyau calcule des tuiles GEMM_MR x GEMM_NR de C dans des registres.
+// Micro-noyau AVX2/FMA si le fichier est compilé avec -mavx2 -mfma (ou -march=native),
+// sinon boucles portables que le compilateur vectorise. Réparti entre getMatrixThreads()
+// threads (Parallel.hpp).
+// Compilé pour double et float (tuiles de GEMM_MR x 2 GEMM_NR en float : un registre
+// contient deux fois plus d'éléments), par rangées et par colonnes : en ColMajor, le
+// produit est calculé comme C^T = B^T A^T sur les vues transposées, sans copie.
+
+// Tuile du micro-noyau : 6 x 8 doubles = 12 registres AVX2 d'accumulation.
+#define GEMM_MR 6
+#define GEMM_NR 8
+// Blocs : A (MC x KC) tient dans L2, B (KC x NC) dans L3, une bande KC x NR de B dans L1.
+#define GEMM_MC 72
+#define GEMM_KC 256
+#define GEMM_NC 4080
+
+// oC = iAlpha * iA * iB + iBeta * oC. oC ne doit chevaucher ni iA ni iB.
+// Le type des éléments et la disposition sont ceux de oC.
+template <typename T, typename Layout>
+void multiplyBlocks(const typename BasicBlockView<T, Layout>::ConstView &iA,
+                    const typename BasicBlockView<T, Layout>::ConstView &iB, const BasicBlockView<T, Layout> &oC,
+                    typename BasicBlockView<T, Layout>::value_type iAlpha = 1,
+                    typename BasicBlockView<T, Layout>::value_type iBeta = 0);
+
+// Multiplier deux matrices.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> multiplyMatrix(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2);
+
+#endif
@@ -0,0 +1,201 @@
+//
+//  Matrix.cpp
+//
+
+#include "Matrix.hpp"
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace std;
+
+// Nombre d'éléments d'une ligne complétée jusqu'à un multiple de MATRIX_ALIGNMENT octets.
+template <typename T>
+static size_t paddedStride(size_t iLength)
+{
+    const size_t lParBloc = MATRIX_ALIGNMENT / sizeof(T);
+    return (iLength + lParBloc - 1) / lParBloc * lParBloc;
+}
+
+// Allouer iSize éléments alignés sur MATRIX_ALIGNMENT octets, initialisés à 0.
+template <typename T>
+static T *allocateAligned(size_t iSize)
+{
+    void *lPtr = NULL;
+    if (posix_memalign(&lPtr, MATRIX_ALIGNMENT, (iSize > 0 ? iSize : 1) * sizeof(T)) != 0)
+        throw bad_alloc();
+    memset(lPtr, 0, iSize * sizeof(T));
+    return (T *)lPtr;
+}
+
+// Construire matrice iRows x iCols et initialiser avec des 0.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout>::BasicMatrix(size_t iRows, size_t iCols)
+    : mRows(iRows), mCols(iCols), mStride(paddedStride<T>(Layout::length(iRows, iCols)))
+{
+    mData = allocateAligned<T>(Layout::lines(mRows, mCols) * mStride);
+}
+
+template <typename T, typename Layout>
+BasicMatrix<T, Layout>::BasicMatrix(const BasicMatrix &iMat) : mRows(iMat.mRows), mCols(iMat.mCols), mStride(iMat.mStride)
+{
+    mData = allocateAligned<T>(Layout::lines(mRows, mCols) * mStride);
+    memcpy(mData, iMat.mData, Layout::lines(mRows, mCols) * mStride * sizeof(T));
+}
+
+template <typename T, typename Layout>
+BasicMatrix<T, Layout>::BasicMatrix(BasicMatrix &&iMat) noexcept
+    : mRows(iMat.mRows), mCols(iMat.mCols), mStride(iMat.mStride), mData(iMat.mData)
+{
+    iMat.mRows = iMat.mCols = iMat.mStride = 0;
+    iMat.mData = NULL;
+}
+
+template <typename T, typename Layout>
+BasicMatrix<T, Layout>::~BasicMatrix(void)
+{
+    free(mData);
+}
+
+// Affecter une matrice de même taille; s'assurer que les tailles sont identiques.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> &BasicMatrix<T, Layout>::operator=(const BasicMatrix &iMat)
+{
+    assert(mRows == iMat.mRows && mCols == iMat.mCols);
+    if (this != &iMat)
+        memcpy(mData, iMat.mData, Layout::lines(mRows, mCols) * mStride * sizeof(T));
+    return *this;
+}
+
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> &BasicMatrix<T, Layout>::operator=(BasicMatrix &&iMat) noexcept
+{
+    assert(mRows == iMat.mRows && mCols == iMat.mCols);
+    std::swap(mData, iMat.mData);
+    return *this;
+}
+
+// Permuter deux rangées de la matrice.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> &BasicMatrix<T, Layout>::swapRows(size_t iR1, size_t iR2)
+{
+    // vérifier la validité des indices de rangée
+    assert(iR1 < rows() && iR2 < rows());
+    // tester la nécessité de permuter
+    if (iR1 == iR2)
+        return *this;
+    // permuter les deux rangées, sur place (contiguës en RowMajor)
+    for (size_t j = 0; j < cols(); ++j)
+        std::swap((*this)(iR1, j), (*this)(iR2, j));
+    return *this;
+}
+
+// Permuter deux colonnes de la matrice.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> &BasicMatrix<T, Layout>::swapColumns(size_t iC1, size_t iC2)
+{
+    // vérifier la validité des indices de colonne
+    assert(iC1 < cols() && iC2 < cols());
+    // tester la nécessité de permuter
+    if (iC1 == iC2)
+        return *this;
+    // permuter les deux colonnes, sur place (contiguës en ColMajor)
+    for (size_t i = 0; i < rows(); ++i)
+        std::swap((*this)(i, iC1), (*this)(i, iC2));
+    return *this;
+}
+
+// Représenter la matrice sous la forme d'une chaîne de caractères.
+// Pratique pour le débuggage...
+template <typename T, typename Layout>
+string BasicMatrix<T, Layout>::str(void) const
+{
+    ostringstream oss;
+    for (size_t i = 0; i < rows(); ++i)
+    {
+        if (i == 0)
+            oss << "[[ ";
+        else
+            oss << " [ ";
+        for (size_t j = 0; j < cols(); ++j)
+        {
+            oss << (*this)(i, j);
+            if (j + 1 != cols())
+                oss << ", ";
+        }
+        if (i + 1 == this->rows())
+            oss << "]]";
+        else
+            oss << " ]," << endl;
+    }
+    return oss.str();
+}
+
+// Construire une matrice identité.
+template <typename T, typename Layout>
+BasicMatrixIdentity<T, Layout>::BasicMatrixIdentity(size_t iSize) : BasicMatrix<T, Layout>(iSize, iSize)
+{
+    for (size_t i = 0; i < iSize; ++i)
+    {
+        (*this)(i, i) = 1;
+    }
+}
+
+// Construire une matrice aléatoire [0,1) iRows x iCols.
+// Utiliser srand pour initialiser le générateur de nombres.
+template <typename T, typename Layout>
+BasicMatrixRandom<T, Layout>::BasicMatrixRandom(size_t iRows, size_t iCols) : BasicMatrix<T, Layout>(iRows, iCols)
+{
+    for (size_t i = 0; i < iRows; ++i)
+    {
+        for (size_t j = 0; j < iCols; ++j)
+            (*this)(i, j) = (T)((double)rand() / RAND_MAX);
+    }
+}
+
+// Construire une matrice en concaténant les colonnes de deux matrices de même hauteur.
+template <typename T, typename Layout>
+BasicMatrixConcatCols<T, Layout>::BasicMatrixConcatCols(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2)
+    : BasicMatrix<T, Layout>(iMat1.rows(), iMat1.cols() + iMat2.cols())
+{
+    // vérifier la compatibilité des matrices
+    assert(iMat1.rows() == iMat2.rows());
+    // les colonnes de la première matrice, puis celles de la seconde
+    this->getBlock(0, 0, this->rows(), iMat1.cols()) = iMat1.getBlock();
+    this->getBlock(0, iMat1.cols(), this->rows(), iMat2.cols()) = iMat2.getBlock();
+}
+
+// Construire une matrice en concaténant les rangées de deux matrices de même largeur.
+template <typename T, typename Layout>
+BasicMatrixConcatRows<T, Layout>::BasicMatrixConcatRows(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2)
+    : BasicMatrix<T, Layout>(iMat1.rows() + iMat2.rows(), iMat1.cols())
+{
+    // vérifier la compatibilité des matrices
+    assert(iMat1.cols() == iMat2.cols());
+    // les rangées de la première matrice, puis celles de la seconde
+    this->getBlock(0, 0, iMat1.rows(), this->cols()) = iMat1.getBlock();
+    this->getBlock(iMat1.rows(), 0, iMat2.rows(), this->cols()) = iMat2.getBlock();
+}
+
+// Insérer une matrice dans un flot de sortie.
+template <typename T, typename Layout>
+ostream &operator<<(ostream &oStream, const BasicMatrix<T, Layout> &iMat)
+{
+    oStream << iMat.str();
+    return oStream;
+}
+
+// Instanciations compilées dans la bibliothèque.
+#define INSTANTIATE_MATRIX(T, Layout)                                                  \
+    template class BasicMatrix<T, Layout>;                                             \
+    template class BasicMatrixIdentity<T, Layout>;                                     \
+    template class BasicMatrixRandom<T, Layout>;                                       \
+    template class BasicMatrixConcatCols<T, Layout>;                                   \
+    template class BasicMatrixConcatRows<T, Layout>;                                   \
+    template ostream &operator<<(ostream &oStream, const BasicMatrix<T, Layout> &iMat);
+
+INSTANTIATE_MATRIX(double, RowMajor)
+INSTANTIATE_MATRIX(float, RowMajor)
+INSTANTIATE_MATRIX(double, ColMajor)
+INSTANTIATE_MATRIX(float, ColMajor)
@@ -0,0 +1,572 @@
+//
+//  Matrix.cpp
+//
+
+#ifndef __MATRIX_HPP__
+#define __MATRIX_HPP__
+
+#include <string>
+#include <valarray>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+// Alignement du stockage et de chaque rangée, en octets (une ligne de cache, un
+// registre AVX-512).
+#define MATRIX_ALIGNMENT 64
+
+// Disposition des éléments en mémoire. Une « ligne » est une suite d'éléments contigus :
+// une rangée en RowMajor, une colonne en ColMajor. Le stockage est fait de lignes
+// alignées, séparées de stride éléments.
+struct ColMajor;
+
+struct RowMajor
+{
+    typedef ColMajor Transposed;
+    static inline std::size_t offset(std::size_t iRow, std::size_t iCol, std::size_t iStride) { return iRow * iStride + iCol; }
+    static inline std::size_t lines(std::size_t iRows, std::size_t) { return iRows; }
+    static inline std::size_t length(std::size_t, std::size_t iCols) { return iCols; }
+};
+
+struct ColMajor
+{
+    typedef RowMajor Transposed;
+    static inline std::size_t offset(std::size_t iRow, std::size_t iCol, std::size_t iStride) { return iCol * iStride + iRow; }
+    static inline std::size_t lines(std::size_t, std::size_t iCols) { return iCols; }
+    static inline std::size_t length(std::size_t iRows, std::size_t) { return iRows; }
+};
+
+// Gabarits d'expression sur les rangées : row_i -= row_k * s ne crée aucun tableau
+// temporaire, l'expression est évaluée élément par élément dans une seule boucle au
+// moment de l'affectation. E est le type de l'expression (CRTP).
+template <typename E>
+class RowExpression
+{
+
+  public:
+    inline const E &self(void) const { return static_cast<const E &>(*this); }
+    inline auto operator[](std::size_t iIndex) const { return self()[iIndex]; }
+    inline std::size_t size(void) const { return self().size(); }
+};
+
+// Expression multipliée par un scalaire (du type des éléments : un float reste un float).
+template <typename E>
+class RowScaled : public RowExpression<RowScaled<E> >
+{
+
+  public:
+    typedef typename E::value_type value_type;
+    RowScaled(const E &iExpr, value_type iScale) : mExpr(iExpr), mScale(iScale) {}
+    inline value_type operator[](std::size_t iIndex) const { return mExpr[iIndex] * mScale; }
+    inline std::size_t size(void) const { return mExpr.size(); }
+
+  private:
+    // Les vues et les noeuds sont petits : copiés, pour ne jamais pointer vers un temporaire.
+    const E mExpr;
+    value_type mScale;
+};
+
+// Somme ou différence élément par élément de deux expressions de même taille.
+template <typename L, typename R, int Signe>
+class RowSum : public RowExpression<RowSum<L, R, Signe> >
+{
+
+  public:
+    typedef typename L::value_type value_type;
+    RowSum(const L &iLeft, const R &iRight) : mLeft(iLeft), mRight(iRight) { assert(iLeft.size() == iRight.size()); }
+    inline value_type operator[](std::size_t iIndex) const { return mLeft[iIndex] + Signe * mRight[iIndex]; }
+    inline std::size_t size(void) const { return mLeft.size(); }
+
+  private:
+    const L mLeft;
+    const R mRight;
+};
+
+template <typename E>
+inline RowScaled<E> operator*(const RowExpression<E> &iExpr, double iScale) { return RowScaled<E>(iExpr.self(), iScale); }
+
+template <typename E>
+inline RowScaled<E> operator*(double iScale, const RowExpression<E> &iExpr) { return RowScaled<E>(iExpr.self(), iScale); }
+
+template <typename E>
+inline RowScaled<E> operator-(const RowExpression<E> &iExpr) { return RowScaled<E>(iExpr.self(), -1); }
+
+template <typename L, typename R>
+inline RowSum<L, R, 1> operator+(const RowExpression<L> &iLeft, const RowExpression<R> &iRight)
+{
+    return RowSum<L, R, 1>(iLeft.self(), iRight.self());
+}
+
+template <typename L, typename R>
+inline RowSum<L, R, -1> operator-(const RowExpression<L> &iLeft, const RowExpression<R> &iRight)
+{
+    return RowSum<L, R, -1>(iLeft.self(), iRight.self());
+}
+
+// Vue sur une rangée (ou une partie de rangée) contiguë d'une matrice : un pointeur
+// et une taille, aucun élément n'est copié. La vue ne possède pas les données et
+// n'est valide que tant que la matrice existe. Sert aussi pour toute ligne contiguë
+// (une colonne d'une matrice ColMajor).
+// Les affectations d'expressions sont compilées en une seule boucle vectorisable
+// (ivdep) : une vue peut apparaître des deux côtés (row = row * 2), mais deux vues
+// d'une même expression ne doivent pas se chevaucher partiellement.
+template <typename T>
+class BasicRowView : public RowExpression<BasicRowView<T> >
+{
+
+  public:
+    typedef typename std::remove_const<T>::type value_type;
+
+    BasicRowView(T *iData, std::size_t iSize) : mData(iData), mSize(iSize) {}
+    // La copie d'une vue désigne les mêmes éléments (l'affectation, elle, les copie).
+    BasicRowView(const BasicRowView &) = default;
+
+    // Une vue modifiable se convertit en vue en lecture seulement.
+    template <typename U>
+    BasicRowView(const BasicRowView<U> &iView) : mData(iView.data()), mSize(iView.size()) {}
+
+    inline T &operator[](std::size_t iIndex) const { return mData[iIndex]; }
+    inline T *data(void) const { return mData; }
+    inline std::size_t size(void) const { return mSize; }
+    inline T *begin(void) const { return mData; }
+    inline T *end(void) const { return mData + mSize; }
+
+    // Comme std::slice_array, l'affectation copie les éléments (et ne déplace pas la vue).
+    const BasicRowView &operator=(const BasicRowView &iView) const { return *this = static_cast<const RowExpression<BasicRowView> &>(iView); }
+
+    template <typename E>
+    const BasicRowView &operator=(const RowExpression<E> &iExpr) const
+    {
+        const E &lExpr = iExpr.self();
+        assert(lExpr.size() == mSize);
+#pragma GCC ivdep
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] = lExpr[j];
+        return *this;
+    }
+
+    template <typename E>
+    const BasicRowView &operator+=(const RowExpression<E> &iExpr) const
+    {
+        const E &lExpr = iExpr.self();
+        assert(lExpr.size() == mSize);
+#pragma GCC ivdep
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] += lExpr[j];
+        return *this;
+    }
+
+    template <typename E>
+    const BasicRowView &operator-=(const RowExpression<E> &iExpr) const
+    {
+        const E &lExpr = iExpr.self();
+        assert(lExpr.size() == mSize);
+#pragma GCC ivdep
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] -= lExpr[j];
+        return *this;
+    }
+
+    // Copier les éléments d'un tableau de même taille dans la rangée.
+    const BasicRowView &operator=(const std::valarray<value_type> &iArray) const
+    {
+        assert(iArray.size() == mSize);
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] = iArray[j];
+        return *this;
+    }
+
+    const BasicRowView &operator+=(const std::valarray<value_type> &iArray) const
+    {
+        assert(iArray.size() == mSize);
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] += iArray[j];
+        return *this;
+    }
+
+    const BasicRowView &operator-=(const std::valarray<value_type> &iArray) const
+    {
+        assert(iArray.size() == mSize);
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] -= iArray[j];
+        return *this;
+    }
+
+    const BasicRowView &operator*=(value_type iValue) const
+    {
+#pragma GCC ivdep
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] *= iValue;
+        return *this;
+    }
+
+    const BasicRowView &operator/=(value_type iValue) const
+    {
+#pragma GCC ivdep
+        for (std::size_t j = 0; j < mSize; ++j)
+            mData[j] /= iValue;
+        return *this;
+    }
+
+    // Copier la rangée dans un nouveau tableau.
+    operator std::valarray<value_type>(void) const { return std::valarray<value_type>(mData, mSize); }
+
+  private:
+    T *mData;
+    std::size_t mSize;
+};
+
+typedef BasicRowView<double> RowView;
+typedef BasicRowView<const double> ConstRowView;
+
+// Vue sur un bloc rectangulaire d'une matrice : iRows x iCols éléments rangés selon
+// Layout, lignes séparées de stride éléments. Aucun élément n'est copié.
+template <typename T, typename Layout = RowMajor>
+class BasicBlockView
+{
+
+  public:
+    typedef typename std::remove_const<T>::type value_type;
+    typedef BasicBlockView<const value_type, Layout> ConstView;
+
+    BasicBlockView(T *iData, std::size_t iRows, std::size_t iCols, std::size_t iStride)
+        : mData(iData), mRows(iRows), mCols(iCols), mStride(iStride) {}
+    BasicBlockView(const BasicBlockView &) = default;
+
+    template <typename U>
+    BasicBlockView(const BasicBlockView<U, Layout> &iView)
+        : mData(iView.data()), mRows(iView.rows()), mCols(iView.cols()), mStride(iView.stride()) {}
+
+    inline T &operator()(std::size_t iRow, std::size_t iCol) const { return mData[Layout::offset(iRow, iCol, mStride)]; }
+    inline T *data(void) const { return mData; }
+    inline std::size_t rows(void) const { return mRows; }
+    inline std::size_t cols(void) const { return mCols; }
+    inline std::size_t stride(void) const { return mStride; }
+
+    // Nombre de lignes contiguës (rangées en RowMajor, colonnes en ColMajor) et ligne iLine.
+    inline std::size_t lineCount(void) const { return Layout::lines(mRows, mCols); }
+    inline BasicRowView<T> getLine(std::size_t iLine) const
+    {
+        assert(iLine < lineCount());
+        return BasicRowView<T>(mData + iLine * mStride, Layout::length(mRows, mCols));
+    }
+
+    // Rangée iRow du bloc (RowMajor seulement : ailleurs une rangée n'est pas contiguë).
+    template <typename L = Layout>
+    inline BasicRowView<T> getRow(std::size_t iRow) const
+    {
+        static_assert(std::is_same<L, RowMajor>::value, "getRow : rangees contigues en RowMajor seulement");
+        return getLine(iRow);
+    }
+
+    // Colonne iCol du bloc (ColMajor seulement).
+    template <typename L = Layout>
+    inline BasicRowView<T> getColumn(std::size_t iCol) const
+    {
+        static_assert(std::is_same<L, ColMajor>::value, "getColumn : colonnes contigues en ColMajor seulement");
+        return getLine(iCol);
+    }
+
+    // Sous-bloc iRows x iCols commençant en (iRow, iCol).
+    inline BasicBlockView getBlock(std::size_t iRow, std::size_t iCol, std::size_t iRows, std::size_t iCols) const
+    {
+        assert(iRow + iRows <= mRows && iCol + iCols <= mCols);
+        return BasicBlockView(mData + Layout::offset(iRow, iCol, mStride), iRows, iCols, mStride);
+    }
+
+    // Vue sur la transposée, sans copie : les mêmes lignes lues dans l'autre disposition.
+    inline BasicBlockView<T, typename Layout::Transposed> transpose(void) const
+    {
+        return BasicBlockView<T, typename Layout::Transposed>(mData, mCols, mRows, mStride);
+    }
+
+    // Comme pour BasicRowView, l'affectation copie les éléments d'un bloc de même taille
+    // (de n'importe quel type d'éléments et disposition).
+    const BasicBlockView &operator=(const BasicBlockView &iBlock) const { return assign(iBlock); }
+
+    template <typename U, typename L>
+    const BasicBlockView &operator=(const BasicBlockView<U, L> &iBlock) const { return assign(iBlock); }
+
+    // Copier le bloc dans un nouveau tableau, rangée par rangée.
+    operator std::valarray<value_type>(void) const
+    {
+        std::valarray<value_type> lArray(mRows * mCols);
+        for (std::size_t i = 0; i < mRows; ++i)
+            for (std::size_t j = 0; j < mCols; ++j)
+                lArray[i * mCols + j] = (*this)(i, j);
+        return lArray;
+    }
+
+  private:
+    // Parcours dans l'ordre des lignes de la destination.
+    template <typename U, typename L>
+    const BasicBlockView &assign(const BasicBlockView<U, L> &iBlock) const
+    {
+        assert(iBlock.rows() == mRows && iBlock.cols() == mCols);
+        if (std::is_same<Layout, RowMajor>::value)
+        {
+            for (std::size_t i = 0; i < mRows; ++i)
+                for (std::size_t j = 0; j < mCols; ++j)
+                    (*this)(i, j) = iBlock(i, j);
+        }
+        else
+        {
+            for (std::size_t j = 0; j < mCols; ++j)
+                for (std::size_t i = 0; i < mRows; ++i)
+                    (*this)(i, j) = iBlock(i, j);
+        }
+        return *this;
+    }
+
+    T *mData;
+    std::size_t mRows, mCols, mStride;
+};
+
+typedef BasicBlockView<double> BlockView;
+typedef BasicBlockView<const double> ConstBlockView;
+
+// La classe BasicMatrix range ses éléments de type T par lignes (Layout) dans un tableau
+// aligné sur MATRIX_ALIGNMENT octets. Chaque ligne est complétée par des zéros jusqu'à
+// un multiple de MATRIX_ALIGNMENT octets (stride() éléments) : toutes les lignes
+// commencent sur une frontière alignée, ce qui permet les accès vectoriels alignés.
+// En float, un registre contient deux fois plus d'éléments et la bande passante est
+// divisée par deux. En ColMajor, les colonnes sont contiguës (getColumn,
+// getColumnCopy) et les rangées ne le sont plus (getRow n'est pas disponible).
+// Les algorithmes travaillent sur des vues (RowView, BlockView) sans copie; les
+// fonctions getRowCopy, getDataArray... retournent des std::valarray comme avant.
+// Matrix est la matrice de double par rangées; les autres instanciations compilées
+// dans la bibliothèque sont MatrixF, MatrixCol et MatrixFCol.
+template <typename T, typename Layout = RowMajor>
+class BasicMatrix
+{
+
+  public:
+    typedef T value_type;
+    typedef BasicRowView<T> RowView;
+    typedef BasicRowView<const T> ConstRowView;
+    typedef BasicBlockView<T, Layout> BlockView;
+    typedef BasicBlockView<const T, Layout> ConstBlockView;
+
+    // Construire matrice iRows x iCols et initialiser avec des 0.
+    BasicMatrix(std::size_t iRows, std::size_t iCols);
+
+    BasicMatrix(const BasicMatrix &iMat);
+    BasicMatrix(BasicMatrix &&iMat) noexcept;
+    ~BasicMatrix(void);
+
+    // Affecter une matrice de même taille; s'assurer que les tailles sont identiques.
+    BasicMatrix &operator=(const BasicMatrix &iMat);
+    BasicMatrix &operator=(BasicMatrix &&iMat) noexcept;
+
+    // Accéder à la case (i, j) en lecture/écriture.
+    inline T &operator()(std::size_t iRow, std::size_t iCol)
+    {
+        return mData[Layout::offset(iRow, iCol, mStride)];
+    }
+
+    // Accéder à la case (i, j) en lecture seulement.
+    inline const T &operator()(size_t iRow, size_t iCol) const
+    {
+        return mData[Layout::offset(iRow, iCol, mStride)];
+    }
+
+    // Retourner le nombre de colonnes.
+    inline std::size_t cols(void) const { return mCols; }
+
+    // Retourner le nombre de lignes.
+    inline std::size_t rows(void) const { return mRows; }
+
+    // Retourner la distance, en éléments, entre le début de deux lignes consécutives.
+    inline std::size_t stride(void) const { return mStride; }
+
+    // Accéder au stockage aligné (lignes de stride() éléments).
+    inline T *data(void) { return mData; }
+    inline const T *data(void) const { return mData; }
+
+    // Retourner une vue sur une ligne contiguë (rangée en RowMajor, colonne en ColMajor).
+    inline RowView getLine(size_t iLine) { return getBlock().getLine(iLine); }
+    inline ConstRowView getLine(size_t iLine) const { return getBlock().getLine(iLine); }
+
+    // Retourner une vue sur une rangée (RowMajor seulement).
+    template <typename L = Layout>
+    inline RowView getRow(size_t iRow) { return getBlock().template getRow<L>(iRow); }
+
+    template <typename L = Layout>
+    inline ConstRowView getRow(size_t iRow) const { return getBlock().template getRow<L>(iRow); }
+
+    // Retourner une vue sur iCount éléments de la rangée iRow à partir de la colonne iCol.
+    template <typename L = Layout>
+    inline RowView getRow(size_t iRow, size_t iCol, size_t iCount)
+    {
+        return getBlock(iRow, iCol, 1, iCount).template getRow<L>(0);
+    }
+
+    template <typename L = Layout>
+    inline ConstRowView getRow(size_t iRow, size_t iCol, size_t iCount) const
+    {
+        return getBlock(iRow, iCol, 1, iCount).template getRow<L>(0);
+    }
+
+    // Retourner une vue sur une colonne (ColMajor seulement).
+    template <typename L = Layout>
+    inline RowView getColumn(size_t iCol) { return getBlock().template getColumn<L>(iCol); }
+
+    template <typename L = Layout>
+    inline ConstRowView getColumn(size_t iCol) const { return getBlock().template getColumn<L>(iCol); }
+
+    // Retourner une vue sur le bloc iRows x iCols commençant en (iRow, iCol).
+    inline BlockView getBlock(size_t iRow, size_t iCol, size_t iRows, size_t iCols)
+    {
+        assert(iRow + iRows <= mRows && iCol + iCols <= mCols);
+        return BlockView(mData + Layout::offset(iRow, iCol, mStride), iRows, iCols, mStride);
+    }
+
+    inline ConstBlockView getBlock(size_t iRow, size_t iCol, size_t iRows, size_t iCols) const
+    {
+        assert(iRow + iRows <= mRows && iCol + iCols <= mCols);
+        return ConstBlockView(mData + Layout::offset(iRow, iCol, mStride), iRows, iCols, mStride);
+    }
+
+    // Retourner une vue sur toute la matrice.
+    inline BlockView getBlock(void) { return BlockView(mData, mRows, mCols, mStride); }
+    inline ConstBlockView getBlock(void) const { return ConstBlockView(mData, mRows, mCols, mStride); }
+
+    // Retourner le tableau d'une colonne de la matrice (copie contiguë en ColMajor).
+    std::valarray<T> getColumnCopy(size_t iCol) const
+    {
+        assert(iCol < mCols);
+        return getColumnSlice(iCol);
+    }
+
+    // Retourner la vue d'une colonne de la matrice (bloc rows() x 1).
+    BlockView getColumnSlice(size_t iCol)
+    {
+        assert(iCol < mCols);
+        return getBlock(0, iCol, mRows, 1);
+    }
+
+    // Retourner la vue d'une colonne de la matrice (bloc rows() x 1).
+    ConstBlockView getColumnSlice(size_t iCol) const
+    {
+        assert(iCol < mCols);
+        return getBlock(0, iCol, mRows, 1);
+    }
+
+    // Retourner le tableau d'une rangée de la matrice.
+    std::valarray<T> getRowCopy(size_t iRow) const
+    {
+        assert(iRow < mRows);
+        return getBlock(iRow, 0, 1, mCols);
+    }
+
+    // Retourner la vue d'une rangée de la matrice.
+    template <typename L = Layout>
+    RowView getRowSlice(size_t iRow) { return getRow<L>(iRow); }
+
+    // Retourner la vue d'une rangée de la matrice.
+    template <typename L = Layout>
+    ConstRowView getRowSlice(size_t iRow) const { return getRow<L>(iRow); }
+
+    // Retourner une copie contiguë (rangée par rangée, sans le remplissage des lignes) des éléments de la matrice.
+    std::valarray<T> getDataArray(void) const { return getBlock(); }
+
+    // Permuter deux rangées de la matrice.
+    BasicMatrix &swapRows(size_t iR1, size_t iR2);
+
+    // Permuter deux colonnes de la matrice.
+    BasicMatrix &swapColumns(size_t iC1, size_t iC2);
+
+    // Représenter la matrice sous la forme d'une chaîne de caractères.
+    // Pratique pour le débuggage...
+    std::string str(void) const;
+
+  protected:
+    // Nombre de rangées et de colonnes, distance entre deux lignes.
+    std::size_t mRows, mCols, mStride;
+    T *mData;
+};
+
+typedef BasicMatrix<double> Matrix;
+typedef BasicMatrix<float> MatrixF;
+typedef BasicMatrix<double, ColMajor> MatrixCol;
+typedef BasicMatrix<float, ColMajor> MatrixFCol;
+
+// Construire une matrice identité.
+template <typename T, typename Layout = RowMajor>
+class BasicMatrixIdentity : public BasicMatrix<T, Layout>
+{
+  public:
+    BasicMatrixIdentity(size_t iSize);
+};
+
+// Construire une matrice aléatoire [0,1) iRows x iCols.
+// Utiliser srand pour initialiser le générateur de nombres.
+template <typename T, typename Layout = RowMajor>
+class BasicMatrixRandom : public BasicMatrix<T, Layout>
+{
+  public:
+    BasicMatrixRandom(size_t iRows, size_t iCols);
+};
+
+// Construire une matrice en concaténant les colonnes de deux matrices de même hauteur.
+template <typename T, typename Layout = RowMajor>
+class BasicMatrixConcatCols : public BasicMatrix<T, Layout>
+{
+  public:
+    BasicMatrixConcatCols(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2);
+};
+
+// Construire une matrice en concaténant les rangées de deux matrices de même largeur.
+template <typename T, typename Layout = RowMajor>
+class BasicMatrixConcatRows : public BasicMatrix<T, Layout>
+{
+  public:
+    BasicMatrixConcatRows(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2);
+};
+
+typedef BasicMatrixIdentity<double> MatrixIdentity;
+typedef BasicMatrixRandom<double> MatrixRandom;
+typedef BasicMatrixConcatCols<double> MatrixConcatCols;
+typedef BasicMatrixConcatRows<double> MatrixConcatRows;
+
+// Insérer une matrice dans un flot de sortie.
+template <typename T, typename Layout>
+std::ostream &operator<<(std::ostream &oStream, const BasicMatrix<T, Layout> &iMat);
+
+
+// std::valarray<double> &operator/(std::valarray<double> arr, double val)
+// {
+//     std::valarray<double> new_array = std::valarray<double>(arr);
+//     for (size_t i = 0; i < arr.size(); ++i)
+//     {
+//         new_array[i] = arr[i] / val;
+//     }
+//     return new_array;
+// }
+// std::valarray<double> &operator/=(std::valarray<double> arr, double val)
+// {
+//     for (size_t i = 0; i < arr.size(); ++i)
+//     {
+//         arr[i] = arr[i] / val;
+//     }
+//     return arr;
+// }
+// std::valarray<double> &operator*(std::valarray<double> arr, double val)
+// {
+//     std::valarray<double> new_array = std::valarray<double>(arr);
+//     for (size_t i = 0; i < arr.size(); ++i)
+//     {
+//         new_array[i] = arr[i] * val;
+//     }
+//     return new_array;
+// }
+// std::valarray<double> &operator*=(std::valarray<double> arr, double val)
+// {
+//     for (size_t i = 0; i < arr.size(); ++i)
+//     {
+//         arr[i] = arr[i] * val;
+//     }
+//     return arr;
+// }
+#endif
@@ -0,0 +1,164 @@
+//
+//  MatrixFile.cpp
+//
+
+#include "MatrixFile.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+#define MATRIX_FILE_MAGIC "MATRIXB"
+#define MATRIX_FILE_VERSION 1
+
+// En-tête du fichier, complété par des zéros jusqu'à MATRIX_ALIGNMENT octets.
+struct MatrixFileHeader
+{
+    char mMagic[8];
+    uint32_t mVersion;
+    uint32_t mType;   // taille d'un élément en octets : 4 (float) ou 8 (double)
+    uint32_t mLayout; // 0 : RowMajor, 1 : ColMajor
+    uint32_t mReserved;
+    uint64_t mRows, mCols, mStride;
+    char mPadding[MATRIX_ALIGNMENT - 48];
+};
+
+static_assert(sizeof(MatrixFileHeader) == MATRIX_ALIGNMENT, "en-tete de MATRIX_ALIGNMENT octets");
+
+template <typename Layout>
+static uint32_t layoutCode(void)
+{
+    return is_same<Layout, RowMajor>::value ? 0 : 1;
+}
+
+// stride d'une ligne de iLength éléments, comme dans BasicMatrix.
+template <typename T>
+static size_t fileStride(size_t iLength)
+{
+    const size_t lParBloc = MATRIX_ALIGNMENT / sizeof(T);
+    return (iLength + lParBloc - 1) / lParBloc * lParBloc;
+}
+
+template <typename T, typename Layout>
+BasicMappedMatrix<T, Layout>::BasicMappedMatrix(const string &iPath) : mMap(MAP_FAILED), mMapSize(0)
+{
+    int lFd = open(iPath.c_str(), O_RDONLY);
+    if (lFd < 0)
+        throw runtime_error("Cannot open matrix file " + iPath);
+    struct stat lStat;
+    MatrixFileHeader lHeader;
+    if (fstat(lFd, &lStat) != 0 || (size_t)lStat.st_size < sizeof(lHeader) ||
+        pread(lFd, &lHeader, sizeof(lHeader), 0) != (ssize_t)sizeof(lHeader))
+    {
+        ::close(lFd);
+        throw runtime_error("Cannot read matrix file header " + iPath);
+    }
+
+    // vérifier que le fichier contient une matrice <T, Layout> complète
+    mRows = lHeader.mRows;
+    mCols = lHeader.mCols;
+    mStride = lHeader.mStride;
+    size_t lLignes = Layout::lines(mRows, mCols);
+    size_t lDisponible = (size_t)lStat.st_size - sizeof(lHeader);
+    bool lValide = memcmp(lHeader.mMagic, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC)) == 0 &&
+                   lHeader.mVersion == MATRIX_FILE_VERSION && lHeader.mType == sizeof(T) &&
+                   lHeader.mLayout == layoutCode<Layout>() && mStride >= Layout::length(mRows, mCols) &&
+                   mStride % (MATRIX_ALIGNMENT / sizeof(T)) == 0 &&
+                   // par division : lLignes * mStride * sizeof(T) peut déborder
+                   mStride <= lDisponible / sizeof(T) / max<size_t>(lLignes, 1);
+    if (!lValide)
+    {
+        ::close(lFd);
+        throw runtime_error("Not a matrix file of the expected type and layout: " + iPath);
+    }
+
+    mMapSize = sizeof(lHeader) + lLignes * mStride * sizeof(T);
+    mMap = mmap(NULL, mMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, lFd, 0);
+    ::close(lFd);
+    if (mMap == MAP_FAILED)
+        throw runtime_error("Cannot map matrix file " + iPath);
+    // lecture séquentielle attendue : lecture anticipée agressive
+    madvise(mMap, mMapSize, MADV_SEQUENTIAL);
+    mData = (T *)((char *)mMap + sizeof(lHeader));
+}
+
+template <typename T, typename Layout>
+BasicMappedMatrix<T, Layout>::~BasicMappedMatrix(void)
+{
+    if (mMap != MAP_FAILED)
+        munmap(mMap, mMapSize);
+}
+
+template <typename T, typename Layout>
+BasicMatrixWriter<T, Layout>::BasicMatrixWriter(const string &iPath, size_t iRows, size_t iCols)
+    : mOut(iPath.c_str(), ios::binary | ios::trunc), mPath(iPath), mLength(Layout::length(iRows, iCols)),
+      mStride(fileStride<T>(Layout::length(iRows, iCols))), mLines(Layout::lines(iRows, iCols)), mWritten(0)
+{
+    if (!mOut)
+        throw runtime_error("Cannot create matrix file " + iPath);
+    MatrixFileHeader lHeader;
+    memset(&lHeader, 0, sizeof(lHeader));
+    memcpy(lHeader.mMagic, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC));
+    lHeader.mVersion = MATRIX_FILE_VERSION;
+    lHeader.mType = sizeof(T);
+    lHeader.mLayout = layoutCode<Layout>();
+    lHeader.mRows = iRows;
+    lHeader.mCols = iCols;
+    lHeader.mStride = mStride;
+    mOut.write((const char *)&lHeader, sizeof(lHeader));
+}
+
+template <typename T, typename Layout>
+BasicMatrixWriter<T, Layout>::~BasicMatrixWriter(void)
+{
+    // close() non appelé : fichier laissé incomplet, sans lancer d'exception
+    if (mOut.is_open())
+        mOut.close();
+}
+
+template <typename T, typename Layout>
+void BasicMatrixWriter<T, Layout>::writeLine(const BasicRowView<const T> &iLine)
+{
+    assert(iLine.size() == mLength && mWritten < mLines);
+    static const T lZeros[MATRIX_ALIGNMENT / sizeof(T)] = {};
+    mOut.write((const char *)&iLine[0], mLength * sizeof(T));
+    mOut.write((const char *)lZeros, (mStride - mLength) * sizeof(T));
+    ++mWritten;
+}
+
+template <typename T, typename Layout>
+void BasicMatrixWriter<T, Layout>::close(void)
+{
+    if (mWritten != mLines)
+        throw runtime_error("Incomplete matrix file " + mPath);
+    mOut.close();
+    if (!mOut)
+        throw runtime_error("Cannot write matrix file " + mPath);
+}
+
+template <typename T, typename Layout>
+void writeMatrix(const string &iPath, const BasicMatrix<T, Layout> &iMat)
+{
+    BasicMatrixWriter<T, Layout> lWriter(iPath, iMat.rows(), iMat.cols());
+    for (size_t l = 0; l < iMat.getBlock().lineCount(); ++l)
+        lWriter.writeLine(iMat.getLine(l));
+    lWriter.close();
+}
+
+// Instanciations compilées dans la bibliothèque.
+#define INSTANTIATE_MATRIX_FILE(T, Layout)                                                                         \
+    template class BasicMappedMatrix<T, Layout>;                                                                   \
+    template class BasicMatrixWriter<T, Layout>;                                                                   \
+    template void writeMatrix(const string &, const BasicMatrix<T, Layout> &);
+
+INSTANTIATE_MATRIX_FILE(double, RowMajor)
+INSTANTIATE_MATRIX_FILE(float, RowMajor)
+INSTANTIATE_MATRIX_FILE(double, ColMajor)
+INSTANTIATE_MATRIX_FILE(float, ColMajor)
@@ -0,0 +1,86 @@
+//
+//  MatrixFile.hpp
+//
+
+#ifndef __MATRIXFILE_HPP__
+#define __MATRIXFILE_HPP__
+
+#include "Matrix.hpp"
+#include <fstream>
+#include <string>
+
+// Format binaire des matrices : un en-tête de MATRIX_ALIGNMENT octets (signature
+// "MATRIXB", version, type des éléments, disposition, rangées, colonnes, stride), puis
+// les lignes telles qu'elles sont en mémoire dans BasicMatrix : stride éléments par
+// ligne, complétées par des zéros. Le contenu est donc aligné dans le fichier comme en
+// mémoire, et un fichier projeté par mmap s'utilise directement comme une vue, sans
+// copie ni analyse. Les nombres sont dans l'ordre des octets de la machine.
+// Compilé pour les mêmes instanciations que Gemm.hpp (double/float, RowMajor/ColMajor).
+
+// Matrice lue d'un fichier binaire par projection en mémoire (mmap). La projection est
+// privée : la vue peut être modifiée (inversion sur place, par exemple) sans que le
+// fichier change, seules les pages modifiées sont copiées. Le type et la disposition
+// du fichier doivent être ceux de l'instanciation.
+template <typename T, typename Layout = RowMajor>
+class BasicMappedMatrix
+{
+
+  public:
+    typedef BasicBlockView<T, Layout> BlockView;
+    typedef BasicBlockView<const T, Layout> ConstBlockView;
+
+    // Projeter le fichier iPath; lance runtime_error s'il ne contient pas une matrice <T, Layout>.
+    explicit BasicMappedMatrix(const std::string &iPath);
+    ~BasicMappedMatrix(void);
+
+    inline std::size_t rows(void) const { return mRows; }
+    inline std::size_t cols(void) const { return mCols; }
+    inline std::size_t stride(void) const { return mStride; }
+
+    inline BlockView getBlock(void) { return BlockView(mData, mRows, mCols, mStride); }
+    inline ConstBlockView getBlock(void) const { return ConstBlockView(mData, mRows, mCols, mStride); }
+
+  private:
+    BasicMappedMatrix(const BasicMappedMatrix &);
+    BasicMappedMatrix &operator=(const BasicMappedMatrix &);
+    void *mMap;
+    std::size_t mMapSize;
+    T *mData;
+    std::size_t mRows, mCols, mStride;
+};
+
+typedef BasicMappedMatrix<double> MappedMatrix;
+
+// Écriture d'une matrice binaire ligne par ligne (rangées en RowMajor, colonnes en
+// ColMajor), sans jamais avoir la matrice entière en mémoire.
+template <typename T, typename Layout = RowMajor>
+class BasicMatrixWriter
+{
+
+  public:
+    // Créer le fichier iPath et écrire l'en-tête d'une matrice iRows x iCols.
+    BasicMatrixWriter(const std::string &iPath, std::size_t iRows, std::size_t iCols);
+    ~BasicMatrixWriter(void);
+
+    // Écrire la ligne suivante (Layout::length éléments).
+    void writeLine(const BasicRowView<const T> &iLine);
+
+    // Vérifier que toutes les lignes sont écrites et fermer le fichier; lance
+    // runtime_error en cas d'erreur d'écriture.
+    void close(void);
+
+  private:
+    BasicMatrixWriter(const BasicMatrixWriter &);
+    BasicMatrixWriter &operator=(const BasicMatrixWriter &);
+    std::ofstream mOut;
+    std::string mPath;
+    std::size_t mLength, mStride, mLines, mWritten;
+};
+
+typedef BasicMatrixWriter<double> MatrixWriter;
+
+// Écrire la matrice dans le fichier binaire iPath.
+template <typename T, typename Layout>
+void writeMatrix(const std::string &iPath, const BasicMatrix<T, Layout> &iMat);
+
+#endif
@@ -0,0 +1,490 @@
+//
+//  MatrixText.cpp
+//
+
+#include "MatrixText.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Fichier texte projeté en mémoire, en lecture seule.
+class TextFile
+{
+
+  public:
+    explicit TextFile(const string &iPath) : mMap(MAP_FAILED), mSize(0)
+    {
+        int lFd = open(iPath.c_str(), O_RDONLY);
+        struct stat lStat;
+        if (lFd < 0 || fstat(lFd, &lStat) != 0)
+        {
+            if (lFd >= 0)
+                close(lFd);
+            throw runtime_error("Cannot open matrix file " + iPath);
+        }
+        mSize = lStat.st_size;
+        if (mSize > 0)
+            mMap = mmap(NULL, mSize, PROT_READ, MAP_PRIVATE, lFd, 0);
+        close(lFd);
+        if (mSize == 0 || mMap == MAP_FAILED)
+            throw runtime_error("Cannot map matrix file " + iPath);
+        madvise(mMap, mSize, MADV_SEQUENTIAL);
+    }
+    ~TextFile(void) { munmap(mMap, mSize); }
+
+    inline const char *begin(void) const { return (const char *)mMap; }
+    inline const char *end(void) const { return (const char *)mMap + mSize; }
+
+  private:
+    TextFile(const TextFile &);
+    TextFile &operator=(const TextFile &);
+    void *mMap;
+    size_t mSize;
+};
+
+// Fin de la ligne qui commence à iDebut (fin de ligne exclue).
+static inline const char *lineEnd(const char *iDebut, const char *iFin)
+{
+    if (iDebut >= iFin)
+        return iFin;
+    const char *q = (const char *)memchr(iDebut, '\n', iFin - iDebut);
+    return q ? q : iFin;
+}
+
+// Bornes des morceaux de [iDebut, iFin) : environ MATRIX_TEXT_CHUNK octets, coupés
+// juste après une fin de ligne.
+static vector<const char *> splitChunks(const char *iDebut, const char *iFin)
+{
+    vector<const char *> lBornes(1, iDebut);
+    const char *p = iDebut;
+    while (iFin - p > MATRIX_TEXT_CHUNK)
+    {
+        const char *q = lineEnd(p + MATRIX_TEXT_CHUNK, iFin);
+        if (q == iFin)
+            break;
+        p = q + 1;
+        lBornes.push_back(p);
+    }
+    if (lBornes.back() != iFin)
+        lBornes.push_back(iFin);
+    return lBornes;
+}
+
+static inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Vrai si la ligne [iDebut, iFin) contient des données : ni vide, ni commentaire
+// (commençant par iCommentaire, 0 : aucun).
+static bool isDataLine(const char *iDebut, const char *iFin, char iCommentaire)
+{
+    while (iDebut < iFin && isBlank(*iDebut))
+        ++iDebut;
+    return iDebut < iFin && *iDebut != iCommentaire;
+}
+
+// Lire un nombre à partir de ioP, espaces sautés; faux si aucun nombre n'y commence.
+template <typename T>
+static bool parseNumber(const char *&ioP, const char *iFin, T &oValue)
+{
+    while (ioP < iFin && isBlank(*ioP))
+        ++ioP;
+    // from_chars refuse le signe +
+    if (ioP < iFin && *ioP == '+')
+        ++ioP;
+    from_chars_result lRes = from_chars(ioP, iFin, oValue);
+    if (lRes.ec != errc())
+        return false;
+    ioP = lRes.ptr;
+    return true;
+}
+
+// Vrai s'il ne reste que des espaces avant iFin.
+static bool atLineEnd(const char *p, const char *iFin)
+{
+    while (p < iFin && isBlank(*p))
+        ++p;
+    return p == iFin;
+}
+
+// Pour chaque morceau, nombre de lignes de données qui le précèdent; le dernier élément
+// est le total.
+static vector<size_t> countDataLines(const vector<const char *> &iBornes, char iCommentaire)
+{
+    size_t lMorceaux = iBornes.size() - 1;
+    vector<size_t> lDebuts(lMorceaux + 1, 0);
+    parallelFor(0, lMorceaux, [&](size_t c) {
+        size_t lLignes = 0;
+        for (const char *p = iBornes[c]; p < iBornes[c + 1];)
+        {
+            const char *q = lineEnd(p, iBornes[c + 1]);
+            if (isDataLine(p, q, iCommentaire))
+                ++lLignes;
+            p = q + 1;
+        }
+        lDebuts[c + 1] = lLignes;
+    }, MATRIX_TEXT_CHUNK);
+    for (size_t c = 0; c < lMorceaux; ++c)
+        lDebuts[c + 1] += lDebuts[c];
+    return lDebuts;
+}
+
+// Appeler iLire(k, debut, fin) pour chaque ligne de données, k étant son rang parmi les
+// lignes de données du fichier, en parallèle par morceau. iLire retourne faux sur une
+// ligne mal formée : le rang de la première est retourné (iDebuts.back() si aucune).
+template <typename F>
+static size_t forEachDataLine(const vector<const char *> &iBornes, const vector<size_t> &iDebuts, char iCommentaire,
+                              const F &iLire)
+{
+    size_t lMorceaux = iBornes.size() - 1;
+    vector<size_t> lErreurs(lMorceaux, iDebuts.back());
+    parallelFor(0, lMorceaux, [&](size_t c) {
+        size_t k = iDebuts[c];
+        for (const char *p = iBornes[c]; p < iBornes[c + 1];)
+        {
+            const char *q = lineEnd(p, iBornes[c + 1]);
+            if (isDataLine(p, q, iCommentaire))
+            {
+                if (!iLire(k, p, q) && lErreurs[c] == iDebuts.back())
+                    lErreurs[c] = k;
+                ++k;
+            }
+            p = q + 1;
+        }
+    }, MATRIX_TEXT_CHUNK);
+    return lMorceaux > 0 ? *min_element(lErreurs.begin(), lErreurs.end()) : iDebuts.back();
+}
+
+// Lire la rangée iRangee de ioMat dans une ligne CSV; faux si la ligne n'a pas exactement
+// ioMat.cols() éléments.
+template <typename T, typename Layout>
+static bool parseCsvRow(const char *p, const char *iFin, BasicMatrix<T, Layout> &ioMat, size_t iRangee)
+{
+    for (size_t j = 0; j < ioMat.cols(); ++j)
+    {
+        if (!parseNumber(p, iFin, ioMat(iRangee, j)))
+            return false;
+        while (p < iFin && isBlank(*p))
+            ++p;
+        if (p < iFin && (*p == ',' || *p == ';'))
+            ++p;
+    }
+    return atLineEnd(p, iFin);
+}
+
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> readCsv(const string &iPath)
+{
+    TextFile lFichier(iPath);
+    vector<const char *> lBornes = splitChunks(lFichier.begin(), lFichier.end());
+    vector<size_t> lDebuts = countDataLines(lBornes, 0);
+
+    // nombre de colonnes : nombres de la première ligne de données
+    size_t lCols = 0;
+    for (const char *p = lFichier.begin(); p < lFichier.end() && lCols == 0;)
+    {
+        const char *q = lineEnd(p, lFichier.end());
+        T lValeur;
+        for (const char *r = p; parseNumber(r, q, lValeur); ++lCols)
+            while (r < q && (isBlank(*r) || *r == ',' || *r == ';'))
+                ++r;
+        p = q + 1;
+    }
+
+    BasicMatrix<T, Layout> lMat(lDebuts.back(), lCols);
+    size_t lErreur = forEachDataLine(lBornes, lDebuts, 0, [&](size_t i, const char *p, const char *q) {
+        return parseCsvRow(p, q, lMat, i);
+    });
+    if (lCols == 0 || lErreur < lMat.rows())
+    {
+        ostringstream lMessage;
+        lMessage << "Malformed CSV row " << lErreur + 1 << " in " << iPath;
+        throw runtime_error(lMessage.str());
+    }
+    return lMat;
+}
+
+// Position (rangée, colonne) de l'élément suivant d'un fichier Matrix Market array, rangé
+// par colonnes : toute la colonne (general), à partir de la diagonale (symmetric) ou
+// sous la diagonale (skew-symmetric, iSaut = 1).
+struct ArrayPosition
+{
+    size_t mRangee, mColonne;
+};
+
+static ArrayPosition arrayPosition(size_t k, size_t iRows, bool iTriangle, size_t iSaut)
+{
+    if (!iTriangle)
+        return ArrayPosition{k % iRows, k / iRows};
+    // colonne j : m - j éléments, le premier au rang S(j) = j m - j (j - 1) / 2
+    size_t m = iRows - iSaut;
+    auto lDebut = [m](size_t j) { return j * m - j * (j - 1) / 2; };
+    double lB = 2.0 * m + 1;
+    size_t j = (size_t)max(0.0, (lB - sqrt(max(0.0, lB * lB - 8.0 * k))) / 2);
+    while (j > 0 && lDebut(j) > k)
+        --j;
+    while (j + 1 < m && lDebut(j + 1) <= k)
+        ++j;
+    return ArrayPosition{j + iSaut + k - lDebut(j), j};
+}
+
+// Élément d'un fichier Matrix Market coordinate, indices à partir de 1.
+template <typename T>
+struct CoordinateEntry
+{
+    size_t mRangee, mColonne;
+    T mValeur;
+};
+
+// Découper une ligne en mots minuscules.
+static vector<string> lowerWords(const char *iDebut, const char *iFin)
+{
+    string lLigne(iDebut, iFin);
+    transform(lLigne.begin(), lLigne.end(), lLigne.begin(), [](unsigned char c) { return tolower(c); });
+    istringstream lFlux(lLigne);
+    vector<string> lMots;
+    string lMot;
+    while (lFlux >> lMot)
+        lMots.push_back(lMot);
+    return lMots;
+}
+
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> readMatrixMarket(const string &iPath)
+{
+    TextFile lFichier(iPath);
+    const char *lFin = lFichier.end();
+
+    // en-tête : %%MatrixMarket matrix format champ symétrie
+    const char *q = lineEnd(lFichier.begin(), lFin);
+    vector<string> lEntete = lowerWords(lFichier.begin(), q);
+    if (lEntete.size() != 5 || lEntete[0] != "%%matrixmarket" || lEntete[1] != "matrix" ||
+        (lEntete[2] != "array" && lEntete[2] != "coordinate") ||
+        (lEntete[3] != "real" && lEntete[3] != "integer" && lEntete[3] != "double" && lEntete[3] != "pattern") ||
+        (lEntete[4] != "general" && lEntete[4] != "symmetric" && lEntete[4] != "skew-symmetric") ||
+        (lEntete[2] == "array" && lEntete[3] == "pattern"))
+        throw runtime_error("Unsupported Matrix Market header in " + iPath);
+    bool lCoordonnees = lEntete[2] == "coordinate", lMotif = lEntete[3] == "pattern";
+    bool lTriangle = lEntete[4] != "general";
+    T lSigne = (lEntete[4] == "skew-symmetric") ? -1 : 1;
+    size_t lSaut = (lEntete[4] == "skew-symmetric") ? 1 : 0;
+
+    // taille : rangées colonnes [éléments], après les commentaires
+    const char *p = q + 1;
+    while (p < lFin && !isDataLine(p, lineEnd(p, lFin), '%'))
+        p = lineEnd(p, lFin) + 1;
+    q = lineEnd(p, lFin);
+    size_t lRows = 0, lCols = 0, lElements = 0;
+    if (p >= lFin || !parseNumber(p, q, lRows) || !parseNumber(p, q, lCols) ||
+        (lCoordonnees && !parseNumber(p, q, lElements)) || !atLineEnd(p, q) || (lTriangle && lRows != lCols))
+        throw runtime_error("Malformed Matrix Market size line in " + iPath);
+    // par division : lRows * lCols, la taille en octets (lignes complétées comprises) et le
+    // nombre d'éléments d'un triangle peuvent déborder
+    size_t lPas = MATRIX_ALIGNMENT / sizeof(T);
+    if (lRows > SIZE_MAX - lPas || lCols > SIZE_MAX - lPas || lRows + lPas > SIZE_MAX / sizeof(T) / (lCols + lPas))
+        throw runtime_error("Matrix Market size too large in " + iPath);
+    if (!lCoordonnees)
+        lElements = lTriangle ? lRows * (lRows + 1) / 2 - lSaut * lRows : lRows * lCols;
+
+    vector<const char *> lBornes = splitChunks(min(q + 1, lFin), lFin);
+    vector<size_t> lDebuts = countDataLines(lBornes, '%');
+    if (lDebuts.back() != lElements)
+        throw runtime_error("Wrong number of Matrix Market entries in " + iPath);
+
+    BasicMatrix<T, Layout> lMat(lRows, lCols);
+    size_t lErreur;
+    if (lCoordonnees)
+    {
+        // i j [valeur], indices à partir de 1, lus en parallèle puis appliqués dans l'ordre
+        // du fichier : deux entrées peuvent viser le même élément (doublons, ou (i, j) et
+        // (j, i) dans un fichier symétrique), la dernière l'emporte
+        vector<CoordinateEntry<T> > lEntrees(lElements);
+        lErreur = forEachDataLine(lBornes, lDebuts, '%', [&](size_t k, const char *p, const char *q) {
+            CoordinateEntry<T> &lEntree = lEntrees[k];
+            lEntree.mValeur = 1;
+            return parseNumber(p, q, lEntree.mRangee) && parseNumber(p, q, lEntree.mColonne) &&
+                   (lMotif || parseNumber(p, q, lEntree.mValeur)) && atLineEnd(p, q) && lEntree.mRangee >= 1 &&
+                   lEntree.mRangee <= lRows && lEntree.mColonne >= 1 && lEntree.mColonne <= lCols;
+        });
+        for (size_t k = 0; k < lErreur; ++k)
+        {
+            const CoordinateEntry<T> &lEntree = lEntrees[k];
+            lMat(lEntree.mRangee - 1, lEntree.mColonne - 1) = lEntree.mValeur;
+            if (lTriangle && lEntree.mRangee != lEntree.mColonne)
+                lMat(lEntree.mColonne - 1, lEntree.mRangee - 1) = lSigne * lEntree.mValeur;
+        }
+    }
+    else
+    {
+        // une valeur par ligne, colonne par colonne
+        lErreur = forEachDataLine(lBornes, lDebuts, '%', [&](size_t k, const char *p, const char *q) {
+            T lValeur;
+            if (!parseNumber(p, q, lValeur) || !atLineEnd(p, q))
+                return false;
+            ArrayPosition lPos = arrayPosition(k, lRows, lTriangle, lSaut);
+            lMat(lPos.mRangee, lPos.mColonne) = lValeur;
+            if (lTriangle && lPos.mRangee != lPos.mColonne)
+                lMat(lPos.mColonne, lPos.mRangee) = lSigne * lValeur;
+            return true;
+        });
+    }
+    if (lErreur < lElements)
+    {
+        ostringstream lMessage;
+        lMessage << "Malformed Matrix Market entry " << lErreur + 1 << " in " << iPath;
+        throw runtime_error(lMessage.str());
+    }
+    return lMat;
+}
+
+// Ajouter la représentation la plus courte de iValue qui se relit à l'identique.
+template <typename T>
+static inline void appendNumber(string &oTexte, T iValue)
+{
+    char lTampon[32];
+    to_chars_result lRes = to_chars(lTampon, lTampon + sizeof(lTampon), iValue);
+    oTexte.append(lTampon, lRes.ptr);
+}
+
+// Écrire dans oOut les morceaux formatés par iFormat(c, texte), c de 0 à iMorceaux :
+// par lots d'un morceau par thread et plus, formatés en parallèle, écrits dans l'ordre.
+template <typename F>
+static void writeChunks(ofstream &oOut, size_t iMorceaux, const F &iFormat)
+{
+    size_t lLot = 4 * getMatrixThreads();
+    vector<string> lTextes(lLot);
+    for (size_t c0 = 0; c0 < iMorceaux; c0 += lLot)
+    {
+        size_t c1 = min(iMorceaux, c0 + lLot);
+        parallelFor(c0, c1, [&](size_t c) {
+            lTextes[c - c0].clear();
+            iFormat(c, lTextes[c - c0]);
+        }, MATRIX_TEXT_CHUNK);
+        for (size_t c = c0; c < c1; ++c)
+            oOut.write(lTextes[c - c0].data(), lTextes[c - c0].size());
+    }
+}
+
+// Nombre d'éléments par morceau pour environ MATRIX_TEXT_CHUNK octets (au plus 24
+// caractères par nombre).
+static size_t elementsPerChunk(void)
+{
+    return MATRIX_TEXT_CHUNK / 24;
+}
+
+// Ouvrir iPath en écriture; lance runtime_error en cas d'échec.
+static void openOutput(ofstream &oOut, const string &iPath)
+{
+    oOut.open(iPath.c_str(), ios::binary | ios::trunc);
+    if (!oOut)
+        throw runtime_error("Cannot create matrix file " + iPath);
+}
+
+static void closeOutput(ofstream &oOut, const string &iPath)
+{
+    oOut.close();
+    if (!oOut)
+        throw runtime_error("Cannot write matrix file " + iPath);
+}
+
+template <typename T, typename Layout>
+void writeCsv(const string &iPath, const BasicMatrix<T, Layout> &iMat)
+{
+    ofstream lOut;
+    openOutput(lOut, iPath);
+    size_t lParMorceau = max<size_t>(1, elementsPerChunk() / max<size_t>(1, iMat.cols()));
+    writeChunks(lOut, (iMat.rows() + lParMorceau - 1) / lParMorceau, [&](size_t c, string &oTexte) {
+        size_t lFin = min(iMat.rows(), (c + 1) * lParMorceau);
+        for (size_t i = c * lParMorceau; i < lFin; ++i)
+        {
+            for (size_t j = 0; j < iMat.cols(); ++j)
+            {
+                if (j > 0)
+                    oTexte += ',';
+                appendNumber(oTexte, iMat(i, j));
+            }
+            oTexte += '\n';
+        }
+    });
+    closeOutput(lOut, iPath);
+}
+
+template <typename T, typename Layout>
+void writeMatrixMarket(const string &iPath, const BasicMatrix<T, Layout> &iMat)
+{
+    ofstream lOut;
+    openOutput(lOut, iPath);
+    lOut << "%%MatrixMarket matrix array real general\n" << iMat.rows() << " " << iMat.cols() << "\n";
+    size_t lParMorceau = max<size_t>(1, elementsPerChunk() / max<size_t>(1, iMat.rows()));
+    writeChunks(lOut, (iMat.cols() + lParMorceau - 1) / lParMorceau, [&](size_t c, string &oTexte) {
+        size_t lFin = min(iMat.cols(), (c + 1) * lParMorceau);
+        for (size_t j = c * lParMorceau; j < lFin; ++j)
+            for (size_t i = 0; i < iMat.rows(); ++i)
+            {
+                appendNumber(oTexte, iMat(i, j));
+                oTexte += '\n';
+            }
+    });
+    closeOutput(lOut, iPath);
+}
+
+static bool hasExtension(const string &iPath, const string &iExtension)
+{
+    return iPath.size() >= iExtension.size() &&
+           iPath.compare(iPath.size() - iExtension.size(), iExtension.size(), iExtension) == 0;
+}
+
+bool isTextMatrixPath(const string &iPath)
+{
+    return hasExtension(iPath, ".csv") || hasExtension(iPath, ".mtx");
+}
+
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> readMatrixText(const string &iPath)
+{
+    if (hasExtension(iPath, ".csv"))
+        return readCsv<T, Layout>(iPath);
+    if (hasExtension(iPath, ".mtx"))
+        return readMatrixMarket<T, Layout>(iPath);
+    throw runtime_error("Unknown text matrix extension: " + iPath);
+}
+
+template <typename T, typename Layout>
+void writeMatrixText(const string &iPath, const BasicMatrix<T, Layout> &iMat)
+{
+    if (hasExtension(iPath, ".csv"))
+        writeCsv(iPath, iMat);
+    else if (hasExtension(iPath, ".mtx"))
+        writeMatrixMarket(iPath, iMat);
+    else
+        throw runtime_error("Unknown text matrix extension: " + iPath);
+}
+
+// Instanciations compilées dans la bibliothèque.
+#define INSTANTIATE_MATRIX_TEXT(T, Layout)                                                                         \
+    template BasicMatrix<T, Layout> readCsv<T, Layout>(const string &);                                            \
+    template void writeCsv(const string &, const BasicMatrix<T, Layout> &);                                        \
+    template BasicMatrix<T, Layout> readMatrixMarket<T, Layout>(const string &);                                   \
+    template void writeMatrixMarket(const string &, const BasicMatrix<T, Layout> &);                               \
+    template BasicMatrix<T, Layout> readMatrixText<T, Layout>(const string &);                                     \
+    template void writeMatrixText(const string &, const BasicMatrix<T, Layout> &);
+
+INSTANTIATE_MATRIX_TEXT(double, RowMajor)
+INSTANTIATE_MATRIX_TEXT(float, RowMajor)
+INSTANTIATE_MATRIX_TEXT(double, ColMajor)
+INSTANTIATE_MATRIX_TEXT(float, ColMajor)
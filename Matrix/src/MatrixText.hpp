@@ -0,0 +1,49 @@
+//
+//  MatrixText.hpp
+//
+
+#ifndef __MATRIXTEXT_HPP__
+#define __MATRIXTEXT_HPP__
+
+#include "Matrix.hpp"
+#include <string>
+
+// Matrices en texte : CSV (une rangée par ligne, éléments séparés par des virgules, des
+// points-virgules ou des espaces) et Matrix Market (format array ou coordinate, champ
+// real, integer ou pattern, symétrie general, symmetric ou skew-symmetric; écrit en
+// array real general). Le fichier est projeté en mémoire et découpé en morceaux
+// d'environ MATRIX_TEXT_CHUNK octets terminés par une fin de ligne : les lignes de chaque
+// morceau sont comptées puis lues en parallèle (Parallel.hpp), les nombres par
+// std::from_chars. À l'écriture, chaque thread formate ses morceaux dans son propre
+// tampon (std::to_chars, représentation la plus courte qui relit la même valeur) et les
+// tampons sont écrits dans l'ordre. Les erreurs de format lancent runtime_error.
+// Compilé pour les mêmes instanciations que Gemm.hpp (double/float, RowMajor/ColMajor).
+
+// Taille visée d'un morceau de texte, en octets.
+#define MATRIX_TEXT_CHUNK (1 << 20)
+
+// Lire / écrire une matrice CSV.
+template <typename T = double, typename Layout = RowMajor>
+BasicMatrix<T, Layout> readCsv(const std::string &iPath);
+
+template <typename T, typename Layout>
+void writeCsv(const std::string &iPath, const BasicMatrix<T, Layout> &iMat);
+
+// Lire / écrire une matrice Matrix Market (.mtx).
+template <typename T = double, typename Layout = RowMajor>
+BasicMatrix<T, Layout> readMatrixMarket(const std::string &iPath);
+
+template <typename T, typename Layout>
+void writeMatrixMarket(const std::string &iPath, const BasicMatrix<T, Layout> &iMat);
+
+// Vrai si iPath désigne une matrice en texte : extension .csv ou .mtx.
+bool isTextMatrixPath(const std::string &iPath);
+
+// Lire / écrire en CSV ou en Matrix Market selon l'extension de iPath.
+template <typename T = double, typename Layout = RowMajor>
+BasicMatrix<T, Layout> readMatrixText(const std::string &iPath);
+
+template <typename T, typename Layout>
+void writeMatrixText(const std::string &iPath, const BasicMatrix<T, Layout> &iMat);
+
+#endif
@@ -0,0 +1,35 @@
+//
+//  Parallel.cpp
+//
+
+#include "Parallel.hpp"
+#include <cstdlib>
+
+// 0 : pas encore fixé, lu dans MATRIX_THREADS ou OpenMP au premier appel.
+static int sMatrixThreads = 0;
+
+// Fixer le nombre de threads des opérations de la bibliothèque (1 : séquentiel).
+void setMatrixThreads(int iThreads)
+{
+    sMatrixThreads = (iThreads > 0) ? iThreads : 1;
+}
+
+// Retourner le nombre de threads des opérations de la bibliothèque.
+int getMatrixThreads(void)
+{
+    if (sMatrixThreads == 0)
+    {
+        const char *lEnv = getenv("MATRIX_THREADS");
+        if (lEnv != NULL && atoi(lEnv) > 0)
+            sMatrixThreads = atoi(lEnv);
+        else
+        {
+#ifdef MATRIX_WITH_OPENMP
+            sMatrixThreads = omp_get_max_threads();
+#else
+            sMatrixThreads = 1;
+#endif
+        }
+    }
+    return sMatrixThreads;
+}
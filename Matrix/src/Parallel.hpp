@@ -0,0 +1,115 @@
+//
+//  Parallel.hpp
+//
+
+#ifndef __PARALLEL_HPP__
+#define __PARALLEL_HPP__
+
+#include <cstddef>
+#ifdef MATRIX_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Parallélisme en mémoire partagée de la bibliothèque Matrix (OpenMP si la bibliothèque
+// est compilée avec, sinon tout est séquentiel). Le nombre de threads vient de
+// MATRIX_THREADS dans l'environnement, sinon de OpenMP ; setMatrixThreads(1) remet
+// la bibliothèque en mode séquentiel, par exemple dans chaque rang MPI.
+
+// En dessous de ce travail total (en opérations), une boucle reste séquentielle :
+// lancer les threads coûterait plus que le calcul.
+#define MATRIX_PARALLEL_MIN_WORK 65536
+
+// Fixer le nombre de threads des opérations de la bibliothèque (1 : séquentiel).
+void setMatrixThreads(int iThreads);
+
+// Retourner le nombre de threads des opérations de la bibliothèque.
+int getMatrixThreads(void);
+
+// Appeler iBody(i) pour i dans [iBegin, iEnd), réparti entre les threads. iWork :
+// travail approximatif d'une itération, pour rester séquentiel sur les petites boucles.
+// Les itérations doivent être indépendantes.
+template <typename F>
+void parallelFor(std::size_t iBegin, std::size_t iEnd, const F &iBody, std::size_t iWork = 1)
+{
+#ifdef MATRIX_WITH_OPENMP
+    int lThreads = getMatrixThreads();
+    bool lParallel = lThreads > 1 && (iEnd - iBegin) * iWork >= MATRIX_PARALLEL_MIN_WORK;
+#pragma omp parallel for schedule(static) num_threads(lThreads) if (lParallel)
+    for (long i = (long)iBegin; i < (long)iEnd; ++i)
+        iBody((std::size_t)i);
+#else
+    (void)iWork;
+    for (std::size_t i = iBegin; i < iEnd; ++i)
+        iBody(i);
+#endif
+}
+
+// Appeler iBody(iThread, iThreads) dans chacun des threads de la bibliothèque, dans une
+// seule région parallèle : les threads restent actifs d'une étape à l'autre et se
+// synchronisent par parallelBarrier() au lieu d'être relancés pour chaque boucle.
+// iBody ne doit pas lancer d'exception.
+template <typename F>
+void parallelRegion(const F &iBody)
+{
+#ifdef MATRIX_WITH_OPENMP
+    int lThreads = getMatrixThreads();
+#pragma omp parallel num_threads(lThreads) if (lThreads > 1)
+    iBody(omp_get_thread_num(), omp_get_num_threads());
+#else
+    iBody(0, 1);
+#endif
+}
+
+// Attendre tous les threads de la région parallèle courante (parallelRegion).
+inline void parallelBarrier(void)
+{
+#ifdef MATRIX_WITH_OPENMP
+#pragma omp barrier
+#endif
+}
+
+// Graphe de tâches : iBody() crée les tâches (spawnTask) dans un seul thread, les autres
+// threads exécutent les tâches prêtes; retourne quand toutes sont terminées. Sans
+// OpenMP, chaque tâche s'exécute à sa création, ce qui respecte les dépendances.
+template <typename F>
+void parallelTasks(const F &iBody)
+{
+#ifdef MATRIX_WITH_OPENMP
+    int lThreads = getMatrixThreads();
+#pragma omp parallel num_threads(lThreads) if (lThreads > 1)
+#pragma omp single
+    iBody();
+#else
+    iBody();
+#endif
+}
+
+// Créer une tâche iTask() qui lit l'objet iIn (NULL : aucun) et modifie ioOut : elle attend
+// les tâches créées avant elle qui modifient l'un ou lisent l'autre. Parmi les tâches
+// prêtes, les plus prioritaires passent d'abord (priorités plafonnées par la variable
+// OMP_MAX_TASK_PRIORITY, 0 par défaut). iTask est copiée et ne doit pas lancer d'exception.
+template <typename F>
+void spawnTask(const F &iTask, const void *iIn, const void *ioOut, int iPriority = 0)
+{
+#ifdef MATRIX_WITH_OPENMP
+    F lTask(iTask);
+    const char *lIn = (const char *)iIn, *lOut = (const char *)ioOut;
+    if (lIn == NULL)
+    {
+#pragma omp task firstprivate(lTask) depend(inout : lOut[0]) priority(iPriority)
+        lTask();
+    }
+    else
+    {
+#pragma omp task firstprivate(lTask) depend(in : lIn[0]) depend(inout : lOut[0]) priority(iPriority)
+        lTask();
+    }
+#else
+    (void)iIn;
+    (void)ioOut;
+    (void)iPriority;
+    iTask();
+#endif
+}
+
+#endif
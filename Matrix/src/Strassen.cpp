@@ -0,0 +1,221 @@
+//
+//  Strassen.cpp
+//
+
+#include "Strassen.hpp"
+#include "Gemm.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+// Distance entre deux rangées d'un bloc temporaire : rangées alignées comme dans Matrix.
+template <typename T>
+static size_t alignedStride(size_t iCols)
+{
+    const size_t lParBloc = MATRIX_ALIGNMENT / sizeof(T);
+    return (iCols + lParBloc - 1) / lParBloc * lParBloc;
+}
+
+// Tampon unique des blocs temporaires, alloué une fois et utilisé comme une pile :
+// chaque niveau de la récursion prend ses trois blocs et les rend en sortant.
+template <typename T>
+class StrassenWorkspace
+{
+
+  public:
+    StrassenWorkspace(size_t iSize) : mData(NULL), mSize(iSize), mTop(0)
+    {
+        if (posix_memalign((void **)&mData, MATRIX_ALIGNMENT, (iSize > 0 ? iSize : 1) * sizeof(T)) != 0)
+            throw bad_alloc();
+    }
+    ~StrassenWorkspace(void) { free(mData); }
+
+    // Prendre un bloc iRows x iCols sur le dessus de la pile.
+    BasicBlockView<T> push(size_t iRows, size_t iCols)
+    {
+        size_t lStride = alignedStride<T>(iCols);
+        assert(mTop + iRows * lStride <= mSize);
+        BasicBlockView<T> lBlock(mData + mTop, iRows, iCols, lStride);
+        mTop += iRows * lStride;
+        return lBlock;
+    }
+
+    // Rendre les blocs pris depuis la position iTop.
+    inline size_t top(void) const { return mTop; }
+    inline void pop(size_t iTop) { mTop = iTop; }
+
+  private:
+    StrassenWorkspace(const StrassenWorkspace &);
+    StrassenWorkspace &operator=(const StrassenWorkspace &);
+    T *mData;
+    size_t mSize, mTop;
+};
+
+// Vrai si le produit m x k par k x n est calculé directement par GEMM.
+static bool isLeaf(size_t iM, size_t iK, size_t iN, size_t iCutoff)
+{
+    return min(iM, min(iK, iN)) <= max<size_t>(iCutoff, 1);
+}
+
+// Taille du tampon nécessaire à strassenRecursive pour ces dimensions.
+template <typename T>
+static size_t workspaceSize(size_t iM, size_t iK, size_t iN, size_t iCutoff)
+{
+    if (isLeaf(iM, iK, iN, iCutoff))
+        return 0;
+    size_t lM = iM / 2, lK = iK / 2, lN = iN / 2;
+    return lM * alignedStride<T>(lK) + lK * alignedStride<T>(lN) + lM * alignedStride<T>(lN) +
+           workspaceSize<T>(lM, lK, lN, iCutoff);
+}
+
+// oC = iA + iSign * iB, rangée par rangée (oC peut être iA ou iB).
+template <typename T>
+static void combine(const BasicBlockView<const T> &iA, const BasicBlockView<const T> &iB, T iSign, const BasicBlockView<T> &oC)
+{
+    parallelFor(0, oC.rows(), [&](size_t i) {
+        oC.getRow(i) = iA.getRow(i) + iB.getRow(i) * iSign;
+    }, oC.cols());
+}
+
+// oC += iSign * iA.
+template <typename T>
+static void accumulate(const BasicBlockView<const T> &iA, T iSign, const BasicBlockView<T> &oC)
+{
+    parallelFor(0, oC.rows(), [&](size_t i) {
+        oC.getRow(i) += iA.getRow(i) * iSign;
+    }, oC.cols());
+}
+
+template <typename T>
+static void strassenRecursive(const BasicBlockView<const T> &iA, const BasicBlockView<const T> &iB, const BasicBlockView<T> &oC,
+                              size_t iCutoff, StrassenWorkspace<T> &ioWork);
+
+// Dimensions paires : un niveau de Strassen-Winograd, ordonnancé pour n'utiliser que
+// trois blocs temporaires X (comme A11), Y (comme B11), Z (comme C11) et les quadrants de C.
+template <typename T>
+static void strassenEven(const BasicBlockView<const T> &iA, const BasicBlockView<const T> &iB, const BasicBlockView<T> &oC,
+                         size_t iCutoff, StrassenWorkspace<T> &ioWork)
+{
+    typedef BasicBlockView<const T> ConstBlockView;
+    typedef BasicBlockView<T> BlockView;
+    size_t lM = iA.rows() / 2, lK = iA.cols() / 2, lN = iB.cols() / 2;
+    ConstBlockView lA11 = iA.getBlock(0, 0, lM, lK), lA12 = iA.getBlock(0, lK, lM, lK);
+    ConstBlockView lA21 = iA.getBlock(lM, 0, lM, lK), lA22 = iA.getBlock(lM, lK, lM, lK);
+    ConstBlockView lB11 = iB.getBlock(0, 0, lK, lN), lB12 = iB.getBlock(0, lN, lK, lN);
+    ConstBlockView lB21 = iB.getBlock(lK, 0, lK, lN), lB22 = iB.getBlock(lK, lN, lK, lN);
+    BlockView lC11 = oC.getBlock(0, 0, lM, lN), lC12 = oC.getBlock(0, lN, lM, lN);
+    BlockView lC21 = oC.getBlock(lM, 0, lM, lN), lC22 = oC.getBlock(lM, lN, lM, lN);
+
+    size_t lTop = ioWork.top();
+    BlockView lX = ioWork.push(lM, lK), lY = ioWork.push(lK, lN), lZ = ioWork.push(lM, lN);
+
+    combine<T>(lA11, lA21, -1.0, lX);                    // S3 = A11 - A21
+    combine<T>(lB22, lB12, -1.0, lY);                    // T3 = B22 - B12
+    strassenRecursive<T>(lX, lY, lC21, iCutoff, ioWork); // C21 = M7 = S3 T3
+    combine<T>(lA21, lA22, 1.0, lX);                     // S1 = A21 + A22
+    combine<T>(lB12, lB11, -1.0, lY);                    // T1 = B12 - B11
+    strassenRecursive<T>(lX, lY, lC22, iCutoff, ioWork); // C22 = M5 = S1 T1
+    combine<T>(lX, lA11, -1.0, lX);                      // S2 = S1 - A11
+    combine<T>(lB22, lY, -1.0, lY);                      // T2 = B22 - T1
+    strassenRecursive<T>(lX, lY, lC12, iCutoff, ioWork); // C12 = M6 = S2 T2
+    strassenRecursive<T>(lA11, lB11, lZ, iCutoff, ioWork);  // Z = M1 = A11 B11
+    accumulate<T>(lZ, 1.0, lC12);                        // C12 = U2 = M1 + M6
+    strassenRecursive<T>(lA12, lB21, lC11, iCutoff, ioWork); // C11 = M2 = A12 B21
+    accumulate<T>(lZ, 1.0, lC11);                        // C11 = U1 = M1 + M2
+    accumulate<T>(lC12, 1.0, lC21);                      // C21 = U3 = U2 + M7
+    accumulate<T>(lC22, 1.0, lC12);                      // C12 = U4 = U2 + M5
+    accumulate<T>(lC21, 1.0, lC22);                      // C22 = U7 = U3 + M5
+    combine<T>(lA12, lX, -1.0, lX);                      // S4 = A12 - S2
+    strassenRecursive<T>(lX, lB22, lZ, iCutoff, ioWork); // Z = M3 = S4 B22
+    accumulate<T>(lZ, 1.0, lC12);                        // C12 = U5 = U4 + M3
+    combine<T>(lY, lB21, -1.0, lY);                      // T4 = T2 - B21
+    strassenRecursive<T>(lA22, lY, lZ, iCutoff, ioWork); // Z = M4 = A22 T4
+    accumulate<T>(lZ, -1.0, lC21);                       // C21 = U6 = U3 - M4
+
+    ioWork.pop(lTop);
+}
+
+// oC = iA * iB.
+template <typename T>
+static void strassenRecursive(const BasicBlockView<const T> &iA, const BasicBlockView<const T> &iB, const BasicBlockView<T> &oC,
+                              size_t iCutoff, StrassenWorkspace<T> &ioWork)
+{
+    size_t lM = iA.rows(), lK = iA.cols(), lN = iB.cols();
+    if (isLeaf(lM, lK, lN, iCutoff))
+    {
+        multiplyBlocks(iA, iB, oC);
+        return;
+    }
+    // partie paire par Strassen, puis épluchage de la dernière rangée / colonne
+    size_t lM2 = lM & ~(size_t)1, lK2 = lK & ~(size_t)1, lN2 = lN & ~(size_t)1;
+    strassenEven(iA.getBlock(0, 0, lM2, lK2), iB.getBlock(0, 0, lK2, lN2), oC.getBlock(0, 0, lM2, lN2), iCutoff, ioWork);
+    if (lK2 < lK)
+        multiplyBlocks(iA.getBlock(0, lK2, lM2, 1), iB.getBlock(lK2, 0, 1, lN2), oC.getBlock(0, 0, lM2, lN2), 1.0, 1.0);
+    if (lN2 < lN)
+        multiplyBlocks(iA.getBlock(0, 0, lM2, lK), iB.getBlock(0, lN2, lK, 1), oC.getBlock(0, lN2, lM2, 1));
+    if (lM2 < lM)
+        multiplyBlocks(iA.getBlock(lM2, 0, 1, lK), iB, oC.getBlock(lM2, 0, 1, lN));
+}
+
+// oC = iA * iB, par rangées.
+template <typename T>
+static void strassenRowMajor(const BasicBlockView<const T> &iA, const BasicBlockView<const T> &iB, const BasicBlockView<T> &oC,
+                             size_t iCutoff)
+{
+    StrassenWorkspace<T> lWork(workspaceSize<T>(iA.rows(), iA.cols(), iB.cols(), iCutoff));
+    strassenRecursive(iA, iB, oC, iCutoff, lWork);
+}
+
+// Par colonnes : C^T = B^T A^T sur les vues transposées (voir Gemm.cpp).
+template <typename T>
+static void strassenLayout(const BasicBlockView<const T, RowMajor> &iA, const BasicBlockView<const T, RowMajor> &iB,
+                           const BasicBlockView<T, RowMajor> &oC, size_t iCutoff)
+{
+    strassenRowMajor(iA, iB, oC, iCutoff);
+}
+
+template <typename T>
+static void strassenLayout(const BasicBlockView<const T, ColMajor> &iA, const BasicBlockView<const T, ColMajor> &iB,
+                           const BasicBlockView<T, ColMajor> &oC, size_t iCutoff)
+{
+    strassenRowMajor(iB.transpose(), iA.transpose(), oC.transpose(), iCutoff);
+}
+
+// oC = iA * iB.
+template <typename T, typename Layout>
+void multiplyStrassen(const typename BasicBlockView<T, Layout>::ConstView &iA,
+                      const typename BasicBlockView<T, Layout>::ConstView &iB, const BasicBlockView<T, Layout> &oC,
+                      size_t iCutoff)
+{
+    // vérifier la compatibilité des blocs
+    assert(iA.cols() == iB.rows() && iA.rows() == oC.rows() && iB.cols() == oC.cols());
+    strassenLayout<T>(iA, iB, oC, iCutoff);
+}
+
+// Multiplier deux matrices par Strassen-Winograd.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> multiplyMatrixStrassen(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2,
+                                              size_t iCutoff)
+{
+    // vérifier la compatibilité des matrices
+    assert(iMat1.cols() == iMat2.rows());
+    BasicMatrix<T, Layout> lRes(iMat1.rows(), iMat2.cols());
+    multiplyStrassen(iMat1.getBlock(), iMat2.getBlock(), lRes.getBlock(), iCutoff);
+    return lRes;
+}
+
+// Instanciations compilées dans la bibliothèque.
+#define INSTANTIATE_STRASSEN(T, Layout)                                                                            \
+    template void multiplyStrassen<T, Layout>(const BasicBlockView<const T, Layout> &,                             \
+                                              const BasicBlockView<const T, Layout> &, const BasicBlockView<T, Layout> &, \
+                                              size_t);                                                             \
+    template BasicMatrix<T, Layout> multiplyMatrixStrassen(const BasicMatrix<T, Layout> &, const BasicMatrix<T, Layout> &, \
+                                                           size_t);
+
+INSTANTIATE_STRASSEN(double, RowMajor)
+INSTANTIATE_STRASSEN(float, RowMajor)
+INSTANTIATE_STRASSEN(double, ColMajor)
+INSTANTIATE_STRASSEN(float, ColMajor)
@@ -0,0 +1,35 @@
+//
+//  Strassen.hpp
+//
+
+#ifndef __STRASSEN_HPP__
+#define __STRASSEN_HPP__
+
+#include "Matrix.hpp"
+
+// Produit matriciel de Strassen-Winograd : 7 produits de demi-taille et 15 additions
+// par niveau au lieu de 8 produits. Sous le seuil (plus petite dimension <= iCutoff),
+// le produit par blocs de Gemm.hpp prend le relais. Les dimensions impaires sont
+// traitées par épluchage : la dernière rangée / colonne est calculée à part avec GEMM.
+// Les blocs temporaires de tous les niveaux viennent d'un seul tampon aligné alloué
+// au départ (StrassenWorkspace), utilisé comme une pile.
+//
+// Moins précis que le produit classique (erreur en norme, pas élément par élément, qui
+// croît d'un facteur constant à chaque niveau) : voir bench_strassen.
+// Compilé pour les mêmes instanciations que Gemm.hpp (double/float, RowMajor/ColMajor).
+
+// Seuil par défaut : en dessous, le gain des 7/8 ne compense plus les additions.
+#define STRASSEN_CUTOFF 512
+
+// oC = iA * iB. oC ne doit chevaucher ni iA ni iB.
+template <typename T, typename Layout>
+void multiplyStrassen(const typename BasicBlockView<T, Layout>::ConstView &iA,
+                      const typename BasicBlockView<T, Layout>::ConstView &iB, const BasicBlockView<T, Layout> &oC,
+                      std::size_t iCutoff = STRASSEN_CUTOFF);
+
+// Multiplier deux matrices par Strassen-Winograd.
+template <typename T, typename Layout>
+BasicMatrix<T, Layout> multiplyMatrixStrassen(const BasicMatrix<T, Layout> &iMat1, const BasicMatrix<T, Layout> &iMat2,
+                                              std::size_t iCutoff = STRASSEN_CUTOFF);
+
+#endif
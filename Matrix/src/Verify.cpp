@@ -0,0 +1,87 @@
+//
+//  Verify.cpp
+//
+
+#include "Verify.hpp"
+#include "Gemm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// Norme infinie, en parcourant les éléments dans l'ordre de la mémoire.
+template <typename T, typename Layout>
+double normInf(const BasicMatrix<T, Layout> &iA)
+{
+    vector<double> lSommes(iA.rows(), 0.0);
+    if (is_same<Layout, RowMajor>::value)
+    {
+        for (size_t i = 0; i < iA.rows(); ++i)
+            for (size_t j = 0; j < iA.cols(); ++j)
+                lSommes[i] += fabs(iA(i, j));
+    }
+    else
+    {
+        for (size_t j = 0; j < iA.cols(); ++j)
+            for (size_t i = 0; i < iA.rows(); ++i)
+                lSommes[i] += fabs(iA(i, j));
+    }
+    return lSommes.empty() ? 0 : *max_element(lSommes.begin(), lSommes.end());
+}
+
+// Les iTrials vecteurs forment les colonnes de R : deux produits n x n par n x iTrials.
+template <typename T, typename Layout>
+double residualFreivalds(const BasicMatrix<T, Layout> &iA, const BasicMatrix<T, Layout> &iX, int iTrials)
+{
+    // vérifier la compatibilité des matrices
+    assert(iA.rows() == iA.cols() && iX.rows() == iA.rows() && iX.cols() == iA.cols());
+    size_t n = iA.rows(), k = (iTrials > 0) ? iTrials : 1;
+    BasicMatrix<T, Layout> lR(n, k);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < k; ++j)
+            lR(i, j) = (rand() & 1) ? 1 : -1;
+
+    BasicMatrix<T, Layout> lAXR = multiplyMatrix(iA, multiplyMatrix(iX, lR));
+    double lResidu = 0;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < k; ++j)
+            lResidu = max(lResidu, fabs((double)lAXR(i, j) - lR(i, j)));
+    return lResidu;
+}
+
+template <typename T, typename Layout>
+double residualInverse(const BasicMatrix<T, Layout> &iA, const BasicMatrix<T, Layout> &iX)
+{
+    // vérifier la compatibilité des matrices
+    assert(iA.rows() == iA.cols() && iX.rows() == iA.rows() && iX.cols() == iA.cols());
+    BasicMatrix<T, Layout> lAX = multiplyMatrix(iA, iX);
+    for (size_t i = 0; i < lAX.rows(); ++i)
+        lAX(i, i) -= 1;
+    return normInf(lAX);
+}
+
+template <typename T, typename Layout>
+bool verifyInverse(const BasicMatrix<T, Layout> &iA, const BasicMatrix<T, Layout> &iX, int iTrials,
+                   double &oResidual)
+{
+    oResidual = (iTrials > 0) ? residualFreivalds(iA, iX, iTrials) : residualInverse(iA, iX);
+    double lTolerance = iA.rows() * numeric_limits<T>::epsilon() * normInf(iA) * normInf(iX);
+    // faux aussi si le résidu ou la tolérance est NaN
+    return oResidual <= lTolerance;
+}
+
+// Instanciations compilées dans la bibliothèque.
+#define INSTANTIATE_VERIFY(T, Layout)                                                                              \
+    template double normInf(const BasicMatrix<T, Layout> &);                                                       \
+    template double residualFreivalds(const BasicMatrix<T, Layout> &, const BasicMatrix<T, Layout> &, int);        \
+    template double residualInverse(const BasicMatrix<T, Layout> &, const BasicMatrix<T, Layout> &);               \
+    template bool verifyInverse(const BasicMatrix<T, Layout> &, const BasicMatrix<T, Layout> &, int, double &);
+
+INSTANTIATE_VERIFY(double, RowMajor)
+INSTANTIATE_VERIFY(float, RowMajor)
+INSTANTIATE_VERIFY(double, ColMajor)
+INSTANTIATE_VERIFY(float, ColMajor)
@@ -0,0 +1,40 @@
+//
+//  Verify.hpp
+//
+
+#ifndef __VERIFY_HPP__
+#define __VERIFY_HPP__
+
+#include "Matrix.hpp"
+
+// Vérification d'une inverse X de A sans refaire le produit A X complet : méthode de
+// Freivalds, A (X R) - R pour un bloc R de iTrials vecteurs aléatoires à composantes
+// +-1, en O(iTrials n^2). Contrairement à la somme des éléments de A X, les erreurs ne
+// peuvent pas se compenser : chaque vecteur donne une borne inférieure de ||A X - I||inf,
+// proche de la vraie valeur en pratique. Compilé pour les mêmes instanciations que
+// Gemm.hpp (double/float, RowMajor/ColMajor).
+
+// Nombre de vecteurs aléatoires par défaut.
+#define VERIFY_TRIALS 10
+
+// Norme infinie : plus grande somme des valeurs absolues d'une rangée.
+template <typename T, typename Layout>
+double normInf(const BasicMatrix<T, Layout> &iA);
+
+// max sur iTrials vecteurs r à composantes +-1 de ||A X r - r||inf (<= ||A X - I||inf).
+template <typename T, typename Layout>
+double residualFreivalds(const BasicMatrix<T, Layout> &iA, const BasicMatrix<T, Layout> &iX,
+                         int iTrials = VERIFY_TRIALS);
+
+// ||A X - I||inf exact, en O(n^3) (produit par GEMM).
+template <typename T, typename Layout>
+double residualInverse(const BasicMatrix<T, Layout> &iA, const BasicMatrix<T, Layout> &iX);
+
+// Vérifier que X est l'inverse de A : résidu de Freivalds sur iTrials vecteurs (résidu
+// exact si iTrials <= 0) dans oResidual, comparé à la tolérance d'une inversion stable,
+// n eps ||A||inf ||X||inf. Retourne faux si le résidu la dépasse (ou n'est pas fini).
+template <typename T, typename Layout>
+bool verifyInverse(const BasicMatrix<T, Layout> &iA, const BasicMatrix<T, Layout> &iX, int iTrials,
+                   double &oResidual);
+
+#endif
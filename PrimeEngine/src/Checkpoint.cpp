@@ -0,0 +1,161 @@
+#include "Checkpoint.hpp"
+#include "Stats.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <gmp.h>
+
+using namespace std;
+
+#define CHECKPOINT_MAGIC "TP1CKPT"
+#define CHECKPOINT_VERSION 2
+
+uint64_t fnv1a(uint64_t empreinte, const char *donnees, size_t taille)
+{
+    for (size_t i = 0; i < taille; i++)
+    {
+        empreinte ^= (unsigned char)donnees[i];
+        empreinte *= 1099511628211ULL;
+    }
+    return empreinte;
+}
+
+uint64_t plan_hash(vect_of_intervalles_t const &intervalles, unsigned long taille_morceau)
+{
+    uint64_t empreinte = FNV_OFFSET;
+    empreinte = fnv1a(empreinte, (const char *)&taille_morceau, sizeof(taille_morceau));
+    for (size_t i = 0; i < intervalles.size(); i++)
+    {
+        char *bas = mpz_get_str(NULL, 16, intervalles.at(i).intervalle_bas.value);
+        char *haut = mpz_get_str(NULL, 16, intervalles.at(i).intervalle_haut.value);
+        empreinte = fnv1a(empreinte, bas, strlen(bas) + 1);
+        empreinte = fnv1a(empreinte, haut, strlen(haut) + 1);
+        free(bas);
+        free(haut);
+    }
+    return empreinte;
+}
+
+static string checkpoint_header(uint64_t empreinte)
+{
+    char entete[64];
+    snprintf(entete, sizeof(entete), "%s %d %016llx\n", CHECKPOINT_MAGIC, CHECKPOINT_VERSION, (unsigned long long)empreinte);
+    return string(entete);
+}
+
+bool checkpoint_load(const char *chemin, uint64_t empreinte, unsigned long nb_morceaux, vector<bool> &morceaux_faits,
+                     vector<vector<Custom_mpz_t> > &resultats, size_t &taille_valide)
+{
+    taille_valide = 0;
+    ifstream fichier(chemin);
+    if (fichier.is_open() == 0)
+        return true; //pas encore de journal : rien à reprendre
+    string contenu((istreambuf_iterator<char>(fichier)), istreambuf_iterator<char>());
+
+    string entete = checkpoint_header(empreinte);
+    if (contenu.size() < entete.size() && entete.compare(0, contenu.size(), contenu) == 0)
+        return true; //arrêt avant l'écriture complète de l'en-tête : rien à reprendre
+    if (contenu.compare(0, entete.size(), entete) != 0)
+        return false;
+
+    //seules les lignes complètes (terminées par '\n') sont prises en compte, jusqu'à la
+    //première ligne invalide
+    size_t debut = entete.size();
+    size_t fin;
+    unsigned long nb_lignes = 0;
+    Custom_mpz_t premier;
+    while ((fin = contenu.find('\n', debut)) != string::npos)
+    {
+        istringstream ligne(contenu.substr(debut, fin - debut));
+        unsigned long id;
+        size_t num_intervalle, nb_premiers;
+        if (!(ligne >> id >> num_intervalle >> nb_premiers) || id >= nb_morceaux || num_intervalle >= resultats.size())
+            break;
+        //fenêtres distribuées dans l'ordre : un id ne dépasse pas de beaucoup le nombre de
+        //lignes déjà écrites
+        if (nb_morceaux == CHECKPOINT_UNKNOWN_TOTAL && id >= nb_lignes + CHECKPOINT_MAX_ID_GAP)
+            break;
+        vector<Custom_mpz_t> premiers_morceau;
+        string nombre;
+        while (ligne >> nombre && mpz_set_str(premier.value, nombre.c_str(), 10) == 0)
+            premiers_morceau.push_back(premier);
+        if (premiers_morceau.size() != nb_premiers || !ligne.eof())
+            break;
+        debut = fin + 1;
+        nb_lignes++;
+        if (id >= morceaux_faits.size())
+            morceaux_faits.resize(id + 1, false);
+        else if (morceaux_faits[id])
+            continue;
+        morceaux_faits[id] = true;
+        resultats[num_intervalle].insert(resultats[num_intervalle].end(),
+                                         make_move_iterator(premiers_morceau.begin()), make_move_iterator(premiers_morceau.end()));
+    }
+    taille_valide = debut;
+    return true;
+}
+
+bool checkpoint_open(checkpoint_t &ckpt, const char *chemin, uint64_t empreinte, double intervalle_sec, size_t taille_valide)
+{
+    pthread_mutex_init(&ckpt.lock, NULL);
+    ckpt.intervalle_ns = (uint64_t)(intervalle_sec * 1e9);
+    ckpt.derniere_ecriture_ns = stats_now_ns();
+    ckpt.en_attente.clear();
+
+    //reprise : retire tout ce qui suit la dernière ligne valide, pour ajouter à la suite
+    if (taille_valide > 0 && truncate(chemin, taille_valide) == 0)
+    {
+        ckpt.fichier = fopen(chemin, "a");
+        return ckpt.fichier != NULL;
+    }
+    ckpt.fichier = fopen(chemin, "w");
+    if (ckpt.fichier == NULL)
+        return false;
+    string entete = checkpoint_header(empreinte);
+    fwrite(entete.data(), 1, entete.size(), ckpt.fichier);
+    fflush(ckpt.fichier);
+    return true;
+}
+
+// Écrit les morceaux en attente ; appelé avec ckpt.lock verrouillé.
+static void checkpoint_flush(checkpoint_t &ckpt)
+{
+    if (!ckpt.en_attente.empty())
+    {
+        fwrite(ckpt.en_attente.data(), 1, ckpt.en_attente.size(), ckpt.fichier);
+        fflush(ckpt.fichier);
+        fsync(fileno(ckpt.fichier));
+        ckpt.en_attente.clear();
+    }
+    ckpt.derniere_ecriture_ns = stats_now_ns();
+}
+
+void checkpoint_record(checkpoint_t &ckpt, unsigned long id, size_t num_intervalle,
+                       Custom_mpz_t const *premiers, size_t nb_premiers)
+{
+    //formate la ligne hors du verrou
+    ostringstream ligne;
+    ligne << id << ' ' << num_intervalle << ' ' << nb_premiers;
+    for (size_t i = 0; i < nb_premiers; i++)
+        ligne << ' ' << premiers[i].value;
+    ligne << '\n';
+    string texte = ligne.str();
+
+    pthread_mutex_lock(&ckpt.lock);
+    ckpt.en_attente += texte;
+    if (stats_now_ns() - ckpt.derniere_ecriture_ns >= ckpt.intervalle_ns)
+        checkpoint_flush(ckpt);
+    pthread_mutex_unlock(&ckpt.lock);
+}
+
+void checkpoint_close(checkpoint_t &ckpt)
+{
+    pthread_mutex_lock(&ckpt.lock);
+    checkpoint_flush(ckpt);
+    fclose(ckpt.fichier);
+    ckpt.fichier = NULL;
+    pthread_mutex_unlock(&ckpt.lock);
+    pthread_mutex_destroy(&ckpt.lock);
+}
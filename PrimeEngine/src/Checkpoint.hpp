@@ -0,0 +1,67 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "Types.hpp"
+#include <stdio.h>
+#include <stdint.h>
+#include <climits>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+// Journal de reprise : fichier texte en ajout seulement.
+//   ligne 1        : TP1CKPT 2 <empreinte du plan en hexadécimal>
+//   lignes suivantes : <id du morceau> <indice de l'intervalle> <nombre de premiers> <premier 1> ... <premier n>
+// Version 2 : l'indice de l'intervalle (dans les intervalles de tous les fichiers du lot)
+// a été ajouté après l'id, pour rendre les premiers repris au bon fichier ; --resume
+// refuse un journal de version 1 (en-tête différent).
+// Une ligne incomplète en fin de fichier (arrêt brutal pendant l'écriture) ou invalide,
+// et tout ce qui la suit, est ignorée puis écrasée à la reprise.
+typedef struct checkpoint_t
+{
+  FILE *fichier;
+  pthread_mutex_t lock;
+  std::string en_attente;         // morceaux terminés pas encore écrits
+  uint64_t intervalle_ns;         // délai minimal entre deux écritures
+  uint64_t derniere_ecriture_ns;
+} checkpoint_t;
+
+// FNV-1a 64 bits, à partir de FNV_OFFSET (aussi utilisé par le format binaire d'intervalles).
+#define FNV_OFFSET 14695981039346656037ULL
+uint64_t fnv1a(uint64_t empreinte, const char *donnees, size_t taille);
+
+// Empreinte des intervalles élagués et de la taille des morceaux : deux exécutions
+// avec la même empreinte produisent exactement le même plan de morceaux.
+uint64_t plan_hash(vect_of_intervalles_t const &intervalles, unsigned long taille_morceau);
+
+// nb_morceaux de checkpoint_load quand le nombre de fenêtres est inconnu (plan sans accès
+// direct). Les fenêtres sont alors distribuées dans l'ordre des id : un id valide reste
+// inférieur au nombre de lignes qui le précèdent plus CHECKPOINT_MAX_ID_GAP (fenêtres en
+// cours ou pas encore écrites lors de l'arrêt), ce qui borne la taille de morceaux_faits.
+#define CHECKPOINT_UNKNOWN_TOTAL ULONG_MAX
+#define CHECKPOINT_MAX_ID_GAP (1UL << 20)
+
+// Relit un journal existant. Marque les morceaux terminés dans morceaux_faits (agrandi
+// au besoin jusqu'au plus grand id relu) et ajoute leurs nombres premiers à
+// resultats[indice de l'intervalle du morceau]. La lecture s'arrête à la première ligne
+// invalide (incomplète, mal formée, id hors des bornes ci-dessus ou intervalle hors du
+// plan) ; taille_valide reçoit la taille du journal jusqu'à la fin de la dernière ligne
+// valide (0 sans journal). Un journal absent, vide ou à l'en-tête incomplet n'est pas une
+// erreur (rien à reprendre) ; retourne false s'il a été produit par un autre plan.
+bool checkpoint_load(const char *chemin, uint64_t empreinte, unsigned long nb_morceaux, std::vector<bool> &morceaux_faits,
+                     std::vector<std::vector<Custom_mpz_t> > &resultats, size_t &taille_valide);
+
+// Ouvre le journal en écriture. En reprise (taille_valide de checkpoint_load non nulle),
+// le fichier existant est tronqué après sa dernière ligne valide et complété ; sinon
+// il est recréé.
+bool checkpoint_open(checkpoint_t &ckpt, const char *chemin, uint64_t empreinte, double intervalle_sec, size_t taille_valide);
+
+// Enregistre un morceau terminé. Le texte est formaté hors du verrou ; le fichier
+// n'est écrit (et synchronisé sur disque) qu'une fois par intervalle_sec.
+void checkpoint_record(checkpoint_t &ckpt, unsigned long id, size_t num_intervalle,
+                       Custom_mpz_t const *premiers, size_t nb_premiers);
+
+// Écrit ce qui reste en attente et ferme le journal.
+void checkpoint_close(checkpoint_t &ckpt);
+
+#endif //CHECKPOINT_HPP
@@ -0,0 +1,94 @@
+#include "Types.hpp"
+#include "Stats.hpp"
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <gmp.h>
+#include <typeinfo>
+#include <string>
+#include <gmpxx.h>
+
+using namespace std;
+
+// Ordre des intervalles par borne inférieure croissante (sort_and_prune).
+static bool mpz_compare(interval_t &a, interval_t &b)
+{
+    if (a.intervalle_bas < b.intervalle_bas)
+        return true;
+    return false;
+}
+
+void swap_intervalle(vect_of_intervalles_t &intervalles)
+{
+    //gere le cas ou les intervalles haut et bas sont inversés
+    Custom_mpz_t tmp;
+    for (int i = 0; i < intervalles.size(); i++)
+    {
+        if ((intervalles.at(i)).intervalle_bas > (intervalles.at(i)).intervalle_haut)
+        //l'intervalle est à l'envers
+        {
+            tmp = (intervalles.at(i)).intervalle_bas;
+            (intervalles.at(i)).intervalle_bas = (intervalles.at(i)).intervalle_haut;
+            (intervalles.at(i)).intervalle_haut = tmp;
+        }
+    }
+}
+
+void sort_and_prune(vect_of_intervalles_t &intervalles)
+{
+    // trie les intervalles dans l'ordre croissant des bornes inférieures
+    sort(intervalles.begin(), intervalles.end(), mpz_compare);
+
+    //supprime les chevauchements d'intervalles
+    size_t i = 0;
+    while (i + 1 < intervalles.size())
+    {
+        if ((intervalles.at(i + 1)).intervalle_bas <= (intervalles.at(i)).intervalle_haut)
+        {
+            if ((intervalles.at(i + 1)).intervalle_haut > (intervalles.at(i)).intervalle_haut)
+            {
+                if ((intervalles.at(i + 1)).intervalle_bas == (intervalles.at(i)).intervalle_bas)
+                {
+                    //même borne inférieure : l'intervalle i est inclus dans l'intervalle i+1
+                    //(le couper avant i+1 le laisserait à l'envers)
+                    intervalles.erase(intervalles.begin() + i);
+                }
+                else
+                {
+                    //les intervalles se chevauchent mais ne sont pas inclus l'un dans l'autre
+                    (intervalles.at(i)).intervalle_haut = (intervalles.at(i + 1)).intervalle_bas - 1;
+                    i++;
+                }
+            }
+            else
+            {
+                //l intervalle i+1 est inclus dans l'intervalle i
+                //Il faut cette fois comparer l'intervalle i à l'intervalle i+2, y compris pour i = 0
+                intervalles.erase(intervalles.begin() + (i + 1));
+            }
+        }
+        else
+        {
+            //les intervalles ne se chevauchent pas
+            i++;
+        }
+    }
+}
+
+void push_result(std::vector<Custom_mpz_t> &outputList, Custom_mpz_t const &nb_premier, int numero_thread)
+{
+#ifdef ENABLE_STATS
+    size_t capacite = outputList.capacity();
+    outputList.push_back(nb_premier);
+    //octets du nouveau tampon du vecteur s'il a grossi, plus les limbs de la copie
+    size_t octets = outputList.back().value->_mp_alloc * sizeof(mp_limb_t);
+    if (outputList.capacity() != capacite)
+        octets += outputList.capacity() * sizeof(Custom_mpz_t);
+    STATS_ADD(numero_thread, primes, 1);
+    STATS_ADD(numero_thread, bytes_allocated, octets);
+#else
+    (void)numero_thread;
+    outputList.push_back(nb_premier);
+#endif
+}
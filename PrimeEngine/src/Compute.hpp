@@ -3,11 +3,11 @@
 
 #include "Types.hpp"
 
-bool mpz_compare(mpz_t big_nb_1, mpz_t big_nb_2);
-
 void swap_intervalle(vect_of_intervalles_t &intervalles);
 
 void sort_and_prune(vect_of_intervalles_t &intervalles);
 
+// Ajoute un nombre premier à la liste de résultats d'un thread (compté si ENABLE_STATS).
+void push_result(std::vector<Custom_mpz_t> &outputList, Custom_mpz_t const &nb_premier, int numero_thread);
 
 #endif //COMPUTE_HPP
@@ -0,0 +1,337 @@
+#include "Engine.hpp"
+#include "Compute.hpp"
+#include "Stats.hpp"
+#include "Checkpoint.hpp"
+#include "Segment.hpp"
+#include "IntervalFile.hpp"
+#include "AllocProfile.hpp"
+#include "Metrics.hpp"
+#include <pthread.h>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <gmp.h>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+#define SUFFIXE_SORTIE ".premiers"
+
+// État d'une exécution, partagé par les threads
+static engine_plan_t const *gPlan = NULL;
+static calcul_fenetre_t gCalculFenetre = NULL;
+static pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER;
+static segment_iterator_t gFenetres; //file partagée de BACKEND_STEALING ; protégée par gLock
+static vector<bool> gMorceauxFaits;  //morceaux déjà terminés lors d'une exécution précédente (--resume)
+static checkpoint_t gCheckpoint;
+static int gNbThreads = 1;
+
+bool backend_parse(string const &nom, backend_t &backend)
+{
+    if (nom == "auto")
+        backend = BACKEND_AUTO;
+    else if (nom == "seq")
+        backend = BACKEND_SEQ;
+    else if (nom == "pthreads")
+        backend = BACKEND_PTHREADS;
+    else if (nom == "openmp")
+        backend = BACKEND_OPENMP;
+    else if (nom == "stealing")
+        backend = BACKEND_STEALING;
+    else
+        return false;
+    return true;
+}
+
+const char *backend_name(backend_t backend)
+{
+    switch (backend)
+    {
+    case BACKEND_SEQ:
+        return "seq";
+    case BACKEND_PTHREADS:
+        return "pthreads";
+    case BACKEND_OPENMP:
+        return "openmp";
+    case BACKEND_STEALING:
+        return "stealing";
+    default:
+        return "auto";
+    }
+}
+
+backend_t engine_auto_backend(engine_plan_t const &plan, int nb_threads)
+{
+    if (!plan.acces_direct)
+        return (nb_threads <= 1) ? BACKEND_SEQ : BACKEND_STEALING;
+    if (nb_threads <= 1 || plan.nb_morceaux <= 1)
+        return BACKEND_SEQ;
+    if (plan.nb_morceaux < (unsigned long)ENGINE_STEALING_MIN * nb_threads)
+        return BACKEND_PTHREADS;
+    return BACKEND_STEALING;
+}
+
+backend_t engine_backend(engine_plan_t const &plan, engine_options_t const &options)
+{
+    if (options.backend == BACKEND_AUTO)
+        return engine_auto_backend(plan, options.nb_threads);
+    // pthreads et openmp prennent les fenêtres par id : impossible au-delà d'un unsigned long
+    if (!plan.acces_direct && (options.backend == BACKEND_PTHREADS || options.backend == BACKEND_OPENMP))
+        return BACKEND_STEALING;
+    return options.backend;
+}
+
+bool engine_plan(vector<string> const &fichiers, unsigned long taille_morceau, engine_plan_t &plan)
+{
+    plan.fichiers = fichiers;
+    plan.taille_morceau = taille_morceau;
+    plan.intervalles.clear();
+    plan.fin_fichiers.clear();
+
+    // Chaque fichier est lu, remis à l'endroit, trié et élagué séparément ; un fichier
+    // binaire (voir primes_convert) est déjà normalisé
+    for (size_t f = 0; f < fichiers.size(); f++)
+    {
+        ALLOC_PHASE("parse");
+        vect_of_intervalles_t intervalles;
+        int binaire = interval_file_load(fichiers[f].c_str(), intervalles);
+        if (binaire < 0)
+        {
+            cerr << "Le fichier binaire " << fichiers[f] << " est illisible ou corrompu.\n";
+            return false;
+        }
+        if (binaire == 0)
+        {
+            if (!read_intervalles_texte(fichiers[f].c_str(), intervalles))
+            {
+                cerr << "Impossible d'ouvrir le fichier " << fichiers[f] << ".\n";
+                return false;
+            }
+            ALLOC_PHASE("prune");
+            if (!intervalles.empty())
+            {
+                swap_intervalle(intervalles);
+                sort_and_prune(intervalles);
+            }
+        }
+        plan.intervalles.insert(plan.intervalles.end(), make_move_iterator(intervalles.begin()), make_move_iterator(intervalles.end()));
+        plan.fin_fichiers.push_back(plan.intervalles.size());
+    }
+    plan.acces_direct = segment_count(plan.intervalles, taille_morceau, plan.premiers_morceaux, plan.nb_morceaux);
+    return true;
+}
+
+// Retourne le fichier d'où vient l'intervalle num_intervalle.
+static size_t fichier_of(size_t num_intervalle)
+{
+    return upper_bound(gPlan->fin_fichiers.begin(), gPlan->fin_fichiers.end(), num_intervalle) - gPlan->fin_fichiers.begin();
+}
+
+// Calcule une fenêtre directement dans la liste de son fichier et l'inscrit au journal.
+static void engine_window(chunk_t const &morceau, param_thread_t *parametre)
+{
+    if (morceau.id < gMorceauxFaits.size() && gMorceauxFaits[morceau.id])
+        return; //deja dans le journal de reprise
+
+    vector<Custom_mpz_t> &sortie = parametre->sorties.at(fichier_of(morceau.num_intervalle));
+    (parametre->outputList).swap(sortie);
+    size_t debut_resultats = (parametre->outputList).size();
+    uint64_t debut_fenetre = metrics_enabled() ? stats_now_ns() : 0;
+    gCalculFenetre(morceau, parametre);
+    if (metrics_enabled())
+    {
+        mpz_class largeur;
+        mpz_sub(largeur.get_mpz_t(), morceau.intervalle.intervalle_haut.value, morceau.intervalle.intervalle_bas.value);
+        metrics_window(parametre->inputNumeroThread, largeur.get_ui(),
+                       (parametre->outputList).size() - debut_resultats, stats_now_ns() - debut_fenetre);
+    }
+    if (gCheckpoint.fichier != NULL)
+        checkpoint_record(gCheckpoint, morceau.id, morceau.num_intervalle,
+                          (parametre->outputList).data() + debut_resultats,
+                          (parametre->outputList).size() - debut_resultats);
+    (parametre->outputList).swap(sortie);
+}
+
+// BACKEND_STEALING : chaque thread prend la prochaine fenêtre de l'itérateur partagé.
+// Utilise un mutex pour s'assurer qu'un morceau ne puisse pas être récupéré par 2 threads.
+static void *stealing_thread(void *arg)
+{
+    param_thread_t *parametre = (param_thread_t *)arg;
+    chunk_t morceauThread; //bornes réutilisées d'un morceau à l'autre
+    while (true)
+    {
+        STATS_TIMER_START(debut_attente);
+        pthread_mutex_lock(&gLock);
+        STATS_TIMER_STOP(parametre->inputNumeroThread, ns_lock_wait, debut_attente);
+        bool morceau_disponible = segment_next(gFenetres, morceauThread);
+        pthread_mutex_unlock(&gLock);
+        if (!morceau_disponible)
+            break;
+        STATS_ADD(parametre->inputNumeroThread, chunks_stolen, 1);
+        engine_window(morceauThread, parametre);
+    }
+    pthread_exit(NULL);
+}
+
+// BACKEND_PTHREADS : le thread i prend les fenêtres i, i + T, i + 2T... sans verrou.
+static void *static_thread(void *arg)
+{
+    param_thread_t *parametre = (param_thread_t *)arg;
+    chunk_t morceauThread;
+    for (unsigned long id = parametre->inputNumeroThread; id < gPlan->nb_morceaux; id += gNbThreads)
+    {
+        segment_at(gPlan->intervalles, gPlan->premiers_morceaux, gPlan->taille_morceau, id, morceauThread);
+        engine_window(morceauThread, parametre);
+    }
+    pthread_exit(NULL);
+}
+
+static void run_pthreads(void *(*fonction)(void *), vector<param_thread_t> &params)
+{
+    vector<pthread_t> Ids_threads(params.size());
+    for (size_t i = 0; i < params.size(); i++)
+        pthread_create(&Ids_threads[i], NULL, fonction, (void *)&(params[i]));
+    //attend la fin des threads
+    for (size_t i = 0; i < params.size(); i++)
+        pthread_join(Ids_threads[i], NULL);
+}
+
+bool engine_execute(engine_plan_t const &plan, engine_options_t const &options,
+                    vector<vector<Custom_mpz_t> > &resultats)
+{
+    backend_t backend = engine_backend(plan, options);
+    if (backend != options.backend && options.backend != BACKEND_AUTO)
+        cerr << "Trop de fenetres pour un acces direct : " << backend_name(options.backend) << " remplace par "
+             << backend_name(backend) << ".\n";
+#ifndef WITH_OPENMP
+    if (backend == BACKEND_OPENMP)
+    {
+        cerr << "Ce programme a été compilé sans OpenMP.\n";
+        return false;
+    }
+#endif
+    gPlan = &plan;
+    gCalculFenetre = options.calcul_fenetre;
+    gNbThreads = (backend == BACKEND_SEQ) ? 1 : options.nb_threads;
+    gMorceauxFaits.clear();
+
+    // Reprise : les morceaux du journal ne sont pas recalculés
+    vector<vector<Custom_mpz_t> > resultats_repris(plan.intervalles.size());
+    if (options.chemin_journal != NULL)
+    {
+        uint64_t empreinte = plan_hash(plan.intervalles, plan.taille_morceau);
+        //sans accès direct, nb_morceaux ne tient pas dans un unsigned long
+        unsigned long nb_morceaux = plan.acces_direct ? plan.nb_morceaux : CHECKPOINT_UNKNOWN_TOTAL;
+        size_t taille_valide = 0;
+        if (options.reprise && !checkpoint_load(options.chemin_journal, empreinte, nb_morceaux, gMorceauxFaits,
+                                                resultats_repris, taille_valide))
+        {
+            cerr << "Le journal " << options.chemin_journal << " ne correspond pas à ces intervalles.\n";
+            return false;
+        }
+        if (!checkpoint_open(gCheckpoint, options.chemin_journal, empreinte, options.intervalle_journal, taille_valide))
+        {
+            cerr << "Impossible d'ouvrir le journal " << options.chemin_journal << ".\n";
+            return false;
+        }
+    }
+
+    if (options.chemin_metriques != NULL &&
+        !metrics_start(options.chemin_metriques, gNbThreads, plan.acces_direct ? plan.nb_morceaux : METRICS_UNKNOWN_TOTAL,
+                       count(gMorceauxFaits.begin(), gMorceauxFaits.end(), true), 1.0))
+    {
+        cerr << "Impossible d'écrire les métriques dans " << options.chemin_metriques << ".\n";
+        return false;
+    }
+
+    ALLOC_PHASE("compute");
+    vector<param_thread_t> params(gNbThreads);
+    for (int i = 0; i < gNbThreads; i++)
+    {
+        params[i].inputNumeroThread = i; //initialisation des inputs de la structure transmise au thread
+        params[i].sorties.resize(plan.fichiers.size());
+    }
+
+    switch (backend)
+    {
+    case BACKEND_SEQ:
+    {
+        chunk_t morceau;
+        segment_iterator_t fenetres;
+        segment_begin(fenetres, plan.intervalles, plan.taille_morceau);
+        while (segment_next(fenetres, morceau))
+            engine_window(morceau, &params[0]);
+        break;
+    }
+    case BACKEND_PTHREADS:
+        run_pthreads(static_thread, params);
+        break;
+    case BACKEND_OPENMP:
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(gNbThreads)
+    {
+        param_thread_t *parametre = &params[omp_get_thread_num()];
+        chunk_t morceau;
+#pragma omp for schedule(dynamic)
+        for (long id = 0; id < (long)plan.nb_morceaux; id++)
+        {
+            segment_at(plan.intervalles, plan.premiers_morceaux, plan.taille_morceau, id, morceau);
+            engine_window(morceau, parametre);
+        }
+    }
+#endif
+        break;
+    default:
+        segment_begin(gFenetres, plan.intervalles, plan.taille_morceau);
+        run_pthreads(stealing_thread, params);
+        break;
+    }
+    if (gCheckpoint.fichier != NULL)
+        checkpoint_close(gCheckpoint);
+    metrics_stop();
+
+    //pour chaque fichier, concatene les vecteurs renvoyés et ceux du journal
+    ALLOC_PHASE("merge");
+    resultats.assign(plan.fichiers.size(), vector<Custom_mpz_t>());
+    for (size_t num_intervalle = 0; num_intervalle < resultats_repris.size(); num_intervalle++)
+    {
+        vector<Custom_mpz_t> &finalList = resultats[fichier_of(num_intervalle)];
+        finalList.insert(finalList.end(),
+                         std::make_move_iterator(resultats_repris[num_intervalle].begin()),
+                         std::make_move_iterator(resultats_repris[num_intervalle].end()));
+    }
+    for (size_t f = 0; f < plan.fichiers.size(); f++)
+    {
+        vector<Custom_mpz_t> &finalList = resultats[f];
+        for (int i = 0; i < gNbThreads; i++)
+        {
+            finalList.insert(finalList.end(),
+                             std::make_move_iterator((params[i].sorties[f]).begin()),
+                             std::make_move_iterator((params[i].sorties[f]).end()));
+        }
+        //trie finalList dans l'ordre croissant
+        sort(finalList.begin(), finalList.end());
+    }
+    return true;
+}
+
+void engine_emit(engine_plan_t const &plan, vector<vector<Custom_mpz_t> > const &resultats, bool lot)
+{
+    ALLOC_PHASE("output");
+    for (size_t f = 0; f < plan.fichiers.size(); f++)
+    {
+        ofstream sortie_fichier;
+        if (lot)
+            sortie_fichier.open((plan.fichiers[f] + SUFFIXE_SORTIE).c_str());
+        ostream &sortie = lot ? sortie_fichier : cout;
+        vector<Custom_mpz_t> const &finalList = resultats[f];
+        for (size_t i = 0; i < finalList.size(); i++)
+        {
+            sortie << (finalList.at(i)).value << '\n';
+        }
+        if (lot)
+            cerr << plan.fichiers[f] << " : " << finalList.size() << " nombres premiers" << endl;
+    }
+}
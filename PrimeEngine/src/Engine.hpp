@@ -0,0 +1,73 @@
+#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+#include "Types.hpp"
+#include <string>
+#include <vector>
+
+// Moteur de recherche de nombres premiers, en trois étapes :
+//   plan    : lit les fichiers d'intervalles (texte ou binaire), normalise chacun et
+//             numérote les fenêtres de l'ensemble ;
+//   execute : calcule les fenêtres avec la stratégie parallèle choisie ;
+//   emit    : écrit les nombres premiers de chaque fichier, triés.
+// Toutes les stratégies traitent exactement les mêmes fenêtres (mêmes id), avec le
+// même moteur de test par fenêtre ; seules la répartition et la synchronisation changent.
+
+typedef enum backend_t
+{
+  BACKEND_AUTO,     // choisi d'après le plan (engine_auto_backend)
+  BACKEND_SEQ,      // un seul thread, fenêtres dans l'ordre
+  BACKEND_PTHREADS, // pthreads, répartition statique : le thread i prend les fenêtres i, i+T, ...
+  BACKEND_OPENMP,   // omp for schedule(dynamic) sur les id de fenêtres
+  BACKEND_STEALING  // pthreads, file partagée : chaque thread prend la prochaine fenêtre libre
+} backend_t;
+
+// Moteur de test d'une fenêtre : compute_segment, compute_segment_opencl...
+typedef void (*calcul_fenetre_t)(chunk_t const &, struct param_thread_t *);
+
+typedef struct engine_plan_t
+{
+  std::vector<std::string> fichiers;
+  vect_of_intervalles_t intervalles;            // intervalles élagués de tous les fichiers, mis bout à bout
+  std::vector<size_t> fin_fichiers;             // fin_fichiers[f] : indice suivant le dernier intervalle du fichier f
+  unsigned long taille_morceau;
+  std::vector<unsigned long> premiers_morceaux; // id de la première fenêtre de chaque intervalle
+  unsigned long nb_morceaux;
+  bool acces_direct; // faux si nb_morceaux ne tiendrait pas dans un unsigned long : fenêtres parcourues dans l'ordre (seq, stealing)
+} engine_plan_t;
+
+typedef struct engine_options_t
+{
+  int nb_threads;
+  backend_t backend;
+  calcul_fenetre_t calcul_fenetre;
+  const char *chemin_journal; // NULL : pas de journal de reprise
+  double intervalle_journal;
+  bool reprise;
+  const char *chemin_metriques; // NULL : pas de métriques en direct (voir Metrics.hpp)
+} engine_options_t;
+
+// En dessous de ENGINE_STEALING_MIN fenêtres par thread, la répartition statique est
+// aussi équilibrée que la file partagée et évite le verrou.
+#define ENGINE_STEALING_MIN 8
+
+bool backend_parse(std::string const &nom, backend_t &backend);
+const char *backend_name(backend_t backend);
+backend_t engine_auto_backend(engine_plan_t const &plan, int nb_threads);
+
+// Stratégie effectivement utilisée : celle des options, sauf auto, et sauf pthreads ou
+// openmp sans accès direct aux fenêtres (remplacées par stealing).
+backend_t engine_backend(engine_plan_t const &plan, engine_options_t const &options);
+
+// Retourne false (message sur stderr) si un fichier est illisible.
+bool engine_plan(std::vector<std::string> const &fichiers, unsigned long taille_morceau, engine_plan_t &plan);
+
+// resultats[f] reçoit les nombres premiers du fichier f, triés. Retourne false si la
+// stratégie n'est pas disponible ou si le journal ne correspond pas au plan.
+bool engine_execute(engine_plan_t const &plan, engine_options_t const &options,
+                    std::vector<std::vector<Custom_mpz_t> > &resultats);
+
+// Un seul fichier : stdout. Un lot : <fichier>.premiers par fichier, et un décompte sur stderr.
+void engine_emit(engine_plan_t const &plan, std::vector<std::vector<Custom_mpz_t> > const &resultats, bool lot);
+
+#endif //ENGINE_HPP
@@ -0,0 +1,127 @@
+#include "IntervalFile.hpp"
+#include "Checkpoint.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gmp.h>
+
+using namespace std;
+
+bool read_intervalles_texte(const char *chemin, vect_of_intervalles_t &intervalles)
+{
+    ifstream prime_nb_file(chemin);
+    if (prime_nb_file.is_open() == 0)
+        return false;
+
+    string line;
+    while (getline(prime_nb_file, line))
+    {
+        interval_t buffer;
+        if (gmp_sscanf(line.c_str(), "%Zd %Zd", buffer.intervalle_bas.value, buffer.intervalle_haut.value) == 2)
+            intervalles.push_back(buffer);
+    }
+    return true;
+}
+
+bool interval_file_write(const char *chemin, vect_of_intervalles_t const &intervalles)
+{
+    //largeur commune : celle de la plus grande borne, au moins 128 bits
+    size_t mots = 2;
+    for (size_t i = 0; i < intervalles.size(); i++)
+    {
+        if (mpz_sgn(intervalles[i].intervalle_bas.value) < 0 || mpz_sgn(intervalles[i].intervalle_haut.value) < 0)
+            return false; //les bornes négatives ne sont pas représentables (mpz_export perd le signe)
+        size_t bits = mpz_sizeinbase(intervalles[i].intervalle_haut.value, 2);
+        if ((bits + 63) / 64 > mots)
+            mots = (bits + 63) / 64;
+    }
+
+    vector<uint64_t> paires(intervalles.size() * 2 * mots, 0);
+    for (size_t i = 0; i < intervalles.size(); i++)
+    {
+        uint64_t *paire = &paires[i * 2 * mots];
+        mpz_export(paire, NULL, -1, sizeof(uint64_t), -1, 0, intervalles[i].intervalle_bas.value);
+        mpz_export(paire + mots, NULL, -1, sizeof(uint64_t), -1, 0, intervalles[i].intervalle_haut.value);
+    }
+
+    interval_file_header_t entete;
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.magique, INTERVAL_FILE_MAGIC, sizeof(INTERVAL_FILE_MAGIC));
+    entete.version = INTERVAL_FILE_VERSION;
+    entete.mots_par_borne = mots;
+    entete.nb_intervalles = intervalles.size();
+    entete.somme_controle = fnv1a(FNV_OFFSET, (const char *)paires.data(), paires.size() * sizeof(uint64_t));
+
+    FILE *fichier = fopen(chemin, "wb");
+    if (fichier == NULL)
+        return false;
+    bool ok = fwrite(&entete, sizeof(entete), 1, fichier) == 1 &&
+              fwrite(paires.data(), sizeof(uint64_t), paires.size(), fichier) == paires.size();
+    return (fclose(fichier) == 0) && ok;
+}
+
+int interval_file_load(const char *chemin, vect_of_intervalles_t &intervalles)
+{
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0)
+        return 0; //l'erreur d'ouverture sera signalée par la lecture texte
+    struct stat infos;
+    if (fstat(fd, &infos) != 0 || infos.st_size < (off_t)sizeof(interval_file_header_t))
+    {
+        close(fd);
+        return 0;
+    }
+    void *projection = mmap(NULL, infos.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (projection == MAP_FAILED)
+        return -1;
+    madvise(projection, infos.st_size, MADV_SEQUENTIAL);
+
+    interval_file_header_t const *entete = (interval_file_header_t const *)projection;
+    //tailles en 64 bits : un mots_par_borne corrompu ne doit pas faire déborder le calcul
+    uint64_t disponible = infos.st_size - sizeof(*entete);
+    uint64_t taille_paire = 2 * 8 * (uint64_t)entete->mots_par_borne;
+    int resultat = 1;
+    if (memcmp(entete->magique, INTERVAL_FILE_MAGIC, sizeof(INTERVAL_FILE_MAGIC)) != 0)
+        resultat = 0;
+    else if (entete->version != INTERVAL_FILE_VERSION || entete->mots_par_borne < 2 ||
+             (entete->nb_intervalles > 0 && taille_paire > disponible) ||
+             entete->nb_intervalles > disponible / taille_paire ||
+             disponible != entete->nb_intervalles * taille_paire)
+        resultat = -1;
+    else
+    {
+        const char *paires = (const char *)projection + sizeof(*entete);
+        size_t taille_paires = infos.st_size - sizeof(*entete);
+        if (fnv1a(FNV_OFFSET, paires, taille_paires) != entete->somme_controle)
+            resultat = -1;
+        else
+        {
+            size_t mots = entete->mots_par_borne;
+            size_t debut = intervalles.size();
+            intervalles.resize(debut + entete->nb_intervalles);
+            for (size_t i = 0; i < entete->nb_intervalles; i++)
+            {
+                const char *paire = paires + i * 2 * 8 * mots;
+                interval_t &intervalle = intervalles[debut + i];
+                mpz_import(intervalle.intervalle_bas.value, mots, -1, sizeof(uint64_t), -1, 0, paire);
+                mpz_import(intervalle.intervalle_haut.value, mots, -1, sizeof(uint64_t), -1, 0, paire + 8 * mots);
+                //le fichier doit être normalisé (chaque intervalle à l'endroit) et trié : le
+                //plan de morceaux en dépend
+                if (mpz_cmp(intervalle.intervalle_bas.value, intervalle.intervalle_haut.value) > 0 ||
+                    (i > 0 && mpz_cmp(intervalle.intervalle_bas.value, intervalles[debut + i - 1].intervalle_haut.value) <= 0))
+                    resultat = -1;
+            }
+            if (resultat < 0)
+                intervalles.resize(debut);
+        }
+    }
+    munmap(projection, infos.st_size);
+    return resultat;
+}
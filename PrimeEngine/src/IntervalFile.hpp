@@ -0,0 +1,39 @@
+#ifndef INTERVALFILE_HPP
+#define INTERVALFILE_HPP
+
+#include "Types.hpp"
+#include <stdint.h>
+
+// Format binaire d'intervalles déjà normalisés (remis à l'endroit, triés, élagués) :
+//   en-tête interval_file_header_t (32 octets)
+//   nb_intervalles paires (bas, haut), chaque borne sur mots_par_borne mots de 64 bits
+//   petit-boutistes (mot de poids faible en premier).
+// mots_par_borne vaut 2 (128 bits) sauf si une borne est plus grande : toutes les
+// bornes du fichier prennent alors la largeur de la plus grande.
+// La somme de contrôle est le FNV-1a des paires.
+#define INTERVAL_FILE_MAGIC "TP1INTV"
+#define INTERVAL_FILE_VERSION 1
+
+typedef struct interval_file_header_t
+{
+  char magique[8]; // "TP1INTV\0"
+  uint32_t version;
+  uint32_t mots_par_borne;
+  uint64_t nb_intervalles;
+  uint64_t somme_controle;
+} interval_file_header_t;
+
+// Lit un fichier texte "<bas> <haut>" par ligne (bornes non normalisées).
+bool read_intervalles_texte(const char *chemin, vect_of_intervalles_t &intervalles);
+
+// Écrit des intervalles normalisés (sortie de sort_and_prune) au format binaire.
+// Retourne false si une borne est négative ou si le fichier ne peut être écrit.
+bool interval_file_write(const char *chemin, vect_of_intervalles_t const &intervalles);
+
+// Projette le fichier en mémoire (mmap) et remplit intervalles sans tri ni élagage.
+// Retourne 1 si le fichier est au format binaire, 0 s'il ne l'est pas (fichier texte,
+// intervalles n'est pas modifié) et -1 s'il est tronqué, corrompu, mal ordonné ou
+// contient un intervalle à l'envers (bas > haut).
+int interval_file_load(const char *chemin, vect_of_intervalles_t &intervalles);
+
+#endif //INTERVALFILE_HPP
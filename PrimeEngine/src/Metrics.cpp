@@ -0,0 +1,130 @@
+#include "Metrics.hpp"
+#include "Stats.hpp"
+#include "Periodic.hpp"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+static thread_metrics_t gMetriques[METRICS_MAX_THREADS];
+static int gNbThreadsMetriques = 0;
+static unsigned long gNbMorceaux = 0;
+static unsigned long gNbFaitsAvant = 0; //repris du journal, pas comptés dans la vitesse
+static uint64_t gDebutMetriques = 0;
+static std::string gChemin;
+
+static bool gActif = false;
+static periodic_thread_t gEcrivain = periodic_thread_t();
+//total à l'écriture précédente, pour la vitesse instantanée
+static uint64_t gCandidatsAvant = 0;
+static uint64_t gNsAvant = 0;
+
+// Mémoire résidente du processus (/proc/self/statm, Linux) ; 0 si indisponible.
+static uint64_t rss_bytes(void)
+{
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL)
+        return 0;
+    unsigned long taille = 0, residente = 0;
+    if (fscanf(statm, "%lu %lu", &taille, &residente) != 2)
+        residente = 0;
+    fclose(statm);
+    return (uint64_t)residente * sysconf(_SC_PAGESIZE);
+}
+
+// Écrit un fichier temporaire puis le renomme : un lecteur ne voit jamais de fichier à moitié écrit.
+static void metrics_write(void *)
+{
+    uint64_t maintenant = stats_now_ns();
+    double ecoule = (maintenant - gDebutMetriques) * 1e-9;
+    uint64_t candidats = 0, premiers = 0, morceaux = 0;
+    for (int i = 0; i < gNbThreadsMetriques; i++)
+    {
+        candidats += gMetriques[i].candidates.load(std::memory_order_relaxed);
+        premiers += gMetriques[i].primes.load(std::memory_order_relaxed);
+        morceaux += gMetriques[i].chunks.load(std::memory_order_relaxed);
+    }
+    unsigned long faits = gNbFaitsAvant + morceaux;
+    unsigned long restants = (faits < gNbMorceaux) ? gNbMorceaux - faits : 0;
+    double vitesse = (maintenant > gNsAvant) ? (candidats - gCandidatsAvant) / ((maintenant - gNsAvant) * 1e-9) : 0;
+    // ETA d'après la vitesse moyenne depuis le début, plus stable que la vitesse instantanée
+    double eta = (morceaux > 0) ? restants * ecoule / morceaux : -1;
+    gCandidatsAvant = candidats;
+    gNsAvant = maintenant;
+
+    std::string temporaire = gChemin + ".tmp";
+    FILE *fichier = fopen(temporaire.c_str(), "w");
+    if (fichier == NULL)
+        return;
+    fprintf(fichier, "# TYPE primes_elapsed_seconds gauge\nprimes_elapsed_seconds %.3f\n", ecoule);
+    fprintf(fichier, "# TYPE primes_candidates_total counter\nprimes_candidates_total %llu\n", (unsigned long long)candidats);
+    fprintf(fichier, "# TYPE primes_candidates_per_second gauge\nprimes_candidates_per_second %.1f\n", vitesse);
+    fprintf(fichier, "# TYPE primes_found_total counter\nprimes_found_total %llu\n", (unsigned long long)premiers);
+    if (gNbMorceaux != METRICS_UNKNOWN_TOTAL)
+        fprintf(fichier, "# TYPE primes_chunks_total gauge\nprimes_chunks_total %lu\n", gNbMorceaux);
+    fprintf(fichier, "# TYPE primes_chunks_done gauge\nprimes_chunks_done %lu\n", faits);
+    if (gNbMorceaux != METRICS_UNKNOWN_TOTAL)
+    {
+        fprintf(fichier, "# TYPE primes_chunks_remaining gauge\nprimes_chunks_remaining %lu\n", restants);
+        fprintf(fichier, "# TYPE primes_eta_seconds gauge\nprimes_eta_seconds %.1f\n", eta);
+    }
+    fprintf(fichier, "# TYPE primes_thread_utilisation gauge\n");
+    for (int i = 0; i < gNbThreadsMetriques; i++)
+        fprintf(fichier, "primes_thread_utilisation{thread=\"%d\"} %.3f\n", i,
+                (ecoule > 0) ? gMetriques[i].ns_busy.load(std::memory_order_relaxed) * 1e-9 / ecoule : 0.0);
+    fprintf(fichier, "# TYPE primes_rss_bytes gauge\nprimes_rss_bytes %llu\n", (unsigned long long)rss_bytes());
+    fclose(fichier);
+    rename(temporaire.c_str(), gChemin.c_str());
+}
+
+bool metrics_start(const char *chemin, int nb_threads, unsigned long nb_morceaux, unsigned long nb_faits,
+                   double periode)
+{
+    gChemin = chemin;
+    FILE *essai = fopen((gChemin + ".tmp").c_str(), "w");
+    if (essai == NULL)
+        return false;
+    fclose(essai);
+
+    assert(nb_threads <= METRICS_MAX_THREADS);
+    gNbThreadsMetriques = nb_threads;
+    for (int i = 0; i < gNbThreadsMetriques; i++)
+    {
+        gMetriques[i].candidates.store(0);
+        gMetriques[i].primes.store(0);
+        gMetriques[i].chunks.store(0);
+        gMetriques[i].ns_busy.store(0);
+    }
+    gNbMorceaux = nb_morceaux;
+    gNbFaitsAvant = nb_faits;
+    gDebutMetriques = stats_now_ns();
+    gCandidatsAvant = 0;
+    gNsAvant = gDebutMetriques;
+    gActif = true;
+    periodic_start(gEcrivain, (periode > 0) ? periode : 1.0, metrics_write, NULL, true);
+    return true;
+}
+
+void metrics_window(int numero_thread, uint64_t nb_candidats, uint64_t nb_premiers, uint64_t ns)
+{
+    thread_metrics_t &metriques = gMetriques[numero_thread];
+    stats_add(metriques.candidates, nb_candidats);
+    stats_add(metriques.primes, nb_premiers);
+    stats_add(metriques.chunks, 1);
+    stats_add(metriques.ns_busy, ns);
+}
+
+void metrics_stop(void)
+{
+    if (!gActif)
+        return;
+    // le thread d'écriture se réveille, écrit l'état final et s'arrête
+    periodic_stop(gEcrivain);
+    gActif = false;
+}
+
+bool metrics_enabled(void)
+{
+    return gActif;
+}
@@ -0,0 +1,48 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+// Métriques en direct d'un calcul (--metrics <fichier>) : un thread de fond réécrit le
+// fichier toutes les secondes, au format texte de Prometheus (lisible par le collecteur
+// textfile de node_exporter, ou avec cat/watch). Contrairement à ENABLE_STATS, rien n'est
+// retiré à la compilation : les compteurs ne sont mis à jour qu'une fois par fenêtre.
+//
+// Métriques écrites :
+//   primes_elapsed_seconds, primes_candidates_total, primes_candidates_per_second,
+//   primes_found_total, primes_chunks_total, primes_chunks_done, primes_chunks_remaining,
+//   primes_eta_seconds, primes_thread_utilisation{thread="i"}, primes_rss_bytes
+
+#define METRICS_MAX_THREADS 256
+
+// nb_morceaux de metrics_start quand le nombre de fenêtres est inconnu (plan sans accès
+// direct) : primes_chunks_total, primes_chunks_remaining et primes_eta_seconds sont omis.
+#define METRICS_UNKNOWN_TOTAL ULONG_MAX
+
+// Une case par thread, écrite par lui seul (sans instruction atomique), lue par le
+// thread d'écriture ; une ligne de cache par case contre le faux partage.
+typedef struct alignas(64) thread_metrics_t
+{
+  std::atomic<uint64_t> candidates; // nombres des fenêtres terminées
+  std::atomic<uint64_t> primes;     // nombres premiers trouvés
+  std::atomic<uint64_t> chunks;     // fenêtres terminées
+  std::atomic<uint64_t> ns_busy;    // temps passé à calculer des fenêtres
+} thread_metrics_t;
+
+// Lance le thread d'écriture. nb_faits : fenêtres déjà terminées (reprise d'un journal).
+// Retourne false si le fichier ne peut pas être écrit.
+bool metrics_start(const char *chemin, int nb_threads, unsigned long nb_morceaux, unsigned long nb_faits,
+                   double periode);
+
+// Fin d'une fenêtre de nb_candidats nombres calculée par le thread numero_thread.
+void metrics_window(int numero_thread, uint64_t nb_candidats, uint64_t nb_premiers, uint64_t ns);
+
+// Arrête le thread et écrit une dernière fois le fichier.
+void metrics_stop(void);
+
+// Vrai entre metrics_start et metrics_stop.
+bool metrics_enabled(void);
+
+#endif //METRICS_HPP
@@ -0,0 +1,210 @@
+#define __CL_ENABLE_EXCEPTIONS
+#define CL_HPP_ENABLE_EXCEPTIONS
+#if defined(__APPLE__) || defined(__MACOSX)
+#include <OpenCL/cl.hpp>
+#else
+#include <CL/cl.hpp>
+#endif
+
+#include "OpenCLPrime.hpp"
+#include "Sieve.hpp"
+#include "Segment.hpp"
+#include "Compute.hpp"
+#include "Stats.hpp"
+#include <stdint.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <gmp.h>
+
+using namespace std;
+
+#ifndef PRIME_MR_KERNEL
+#define PRIME_MR_KERNEL "./src/prime_mr.cl"
+#endif
+#define NB_BASES 12 //bases 2 à 37 : test déterministe sous 3.3e24
+
+// File, noyau et tampons propres à chaque thread : un cl::Kernel ne peut pas recevoir
+// ses arguments depuis plusieurs threads à la fois.
+typedef struct opencl_thread_t
+{
+    cl::CommandQueue queue;
+    cl::Kernel kernel;
+    cl::Buffer candidatsBuffer;
+    cl::Buffer resultatsBuffer;
+    size_t capacite;
+    vector<cl_ulong2> candidats;
+    vector<cl_uchar> resultats;
+    vector<unsigned long> positions; //position de chaque candidat dans la fenêtre
+} opencl_thread_t;
+
+static cl::Context gContexte;
+static vector<opencl_thread_t> gOpenCLThreads;
+
+bool opencl_init(int nb_threads, bool gpu)
+{
+    try
+    {
+        ////////////////////////////////////////
+        // Liste les plateformes disponibles  //
+        ////////////////////////////////////////
+        vector<cl::Platform> platforms;
+        cl::Platform::get(&platforms);
+        if (platforms.size() == 0)
+        {
+            cerr << "Pas de plateformes OpenCL disponibles ! Vérifier vos installations\n";
+            return false;
+        }
+
+        ////////////////////////////////////////
+        //  Crée le contexte sur la première  //
+        //  plateforme qui a le bon device    //
+        ////////////////////////////////////////
+        cl_device_type type = gpu ? CL_DEVICE_TYPE_GPU : CL_DEVICE_TYPE_CPU;
+        vector<cl::Device> devices;
+        for (size_t i = 0; i < platforms.size() && devices.empty(); i++)
+        {
+            try
+            {
+                cl_context_properties contex_props[] = {CL_CONTEXT_PLATFORM, (cl_context_properties)(platforms[i])(), 0};
+                gContexte = cl::Context(type, contex_props);
+                devices = gContexte.getInfo<CL_CONTEXT_DEVICES>();
+            }
+            catch (cl::Error &err)
+            {
+                //pas de device de ce type sur cette plateforme
+            }
+        }
+        if (devices.empty())
+        {
+            cerr << "Aucun device OpenCL " << (gpu ? "GPU" : "CPU") << " trouvé.\n";
+            return false;
+        }
+        cerr << "OpenCL : " << devices[0].getInfo<CL_DEVICE_NAME>() << endl;
+
+        ////////////////////////////////////////
+        //   Charge et compile le kernel      //
+        ////////////////////////////////////////
+        ifstream file(PRIME_MR_KERNEL);
+        if (file.is_open() == false)
+        {
+            cerr << "Le fichier de kernel " << PRIME_MR_KERNEL << " n'est pas loadé !\n";
+            return false;
+        }
+        string prog(istreambuf_iterator<char>(file), (istreambuf_iterator<char>()));
+        cl::Program::Sources source(1, make_pair(prog.c_str(), prog.length()));
+        cl::Program program = cl::Program(gContexte, source);
+        try
+        {
+            program.build(devices);
+        }
+        // Get le log d'erreur si jamais problème dans le kernel
+        catch (cl::Error &err)
+        {
+            if (err.err() == CL_BUILD_PROGRAM_FAILURE)
+            {
+                string buildlog = program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(devices[0]);
+                cerr << "Build log for " << devices[0].getInfo<CL_DEVICE_NAME>() << ":" << endl
+                     << buildlog << endl;
+                return false;
+            }
+            throw err;
+        }
+
+        ////////////////////////////////////////
+        //   Une file et un noyau par thread  //
+        ////////////////////////////////////////
+        gOpenCLThreads.resize(nb_threads);
+        for (int i = 0; i < nb_threads; i++)
+        {
+            gOpenCLThreads[i].queue = cl::CommandQueue(gContexte, devices[0]);
+            gOpenCLThreads[i].kernel = cl::Kernel(program, "miller_rabin_128");
+            gOpenCLThreads[i].capacite = 0;
+        }
+    }
+    catch (cl::Error &err)
+    {
+        cerr << "Erreur OpenCL : " << err.what() << " (" << err.err() << ")\n";
+        return false;
+    }
+    return true;
+}
+
+// Écrit n (< 2^128) en deux mots de 64 bits ; false s'il est plus grand.
+static bool mpz_to_128(mpz_srcptr n, uint64_t &bas, uint64_t &haut)
+{
+    if (mpz_sizeinbase(n, 2) > 128)
+        return false;
+    uint64_t mots[2] = {0, 0};
+    mpz_export(mots, NULL, -1, sizeof(uint64_t), 0, 0, n);
+    bas = mots[0];
+    haut = mots[1];
+    return true;
+}
+
+void compute_segment_opencl(chunk_t const &morceau, struct param_thread_t *parametre)
+{
+    mpz_srcptr bas = morceau.intervalle.intervalle_bas.value;
+    uint64_t bas_x, bas_y, haut_x, haut_y;
+    //le noyau suppose des candidats impairs supérieurs à 37 : la fenêtre doit être criblée
+    if (!mpz_to_128(morceau.intervalle.intervalle_haut.value, haut_x, haut_y) ||
+        !sieve_window(morceau, parametre->crible))
+    {
+        compute_segment(morceau, parametre);
+        return;
+    }
+    mpz_to_128(bas, bas_x, bas_y);
+
+    //rassemble les survivants du crible
+    opencl_thread_t &cl_thread = gOpenCLThreads.at(parametre->inputNumeroThread);
+    vector<unsigned char> const &crible = parametre->crible;
+    cl_thread.candidats.clear();
+    cl_thread.positions.clear();
+    for (unsigned long k = 0; k < crible.size(); k++)
+    {
+        if (crible[k] == 0)
+            continue;
+        cl_ulong2 candidat;
+        candidat.s[0] = bas_x + k;
+        candidat.s[1] = bas_y + (candidat.s[0] < bas_x);
+        cl_thread.candidats.push_back(candidat);
+        cl_thread.positions.push_back(k);
+    }
+    cl_uint nb_candidats = cl_thread.candidats.size();
+    if (nb_candidats == 0)
+        return;
+    STATS_ADD(parametre->inputNumeroThread, candidates, nb_candidats);
+
+    STATS_TIMER_START(debut_test);
+    //les tampons du device grandissent avec la plus grande fenêtre vue
+    if (nb_candidats > cl_thread.capacite)
+    {
+        cl_thread.capacite = nb_candidats;
+        cl_thread.candidatsBuffer = cl::Buffer(gContexte, CL_MEM_READ_ONLY, nb_candidats * sizeof(cl_ulong2));
+        cl_thread.resultatsBuffer = cl::Buffer(gContexte, CL_MEM_WRITE_ONLY, nb_candidats * sizeof(cl_uchar));
+    }
+    cl_thread.resultats.resize(nb_candidats);
+    cl_thread.queue.enqueueWriteBuffer(cl_thread.candidatsBuffer, CL_FALSE, 0, nb_candidats * sizeof(cl_ulong2),
+                                       cl_thread.candidats.data());
+    cl_thread.kernel.setArg(0, cl_thread.candidatsBuffer);
+    cl_thread.kernel.setArg(1, cl_thread.resultatsBuffer);
+    cl_thread.kernel.setArg(2, nb_candidats);
+    cl_thread.kernel.setArg(3, (cl_uint)NB_BASES);
+    cl_thread.queue.enqueueNDRangeKernel(cl_thread.kernel, cl::NullRange, cl::NDRange(nb_candidats), cl::NullRange);
+    cl_thread.queue.enqueueReadBuffer(cl_thread.resultatsBuffer, CL_TRUE, 0, nb_candidats * sizeof(cl_uchar),
+                                      cl_thread.resultats.data());
+
+    //confirmation par GMP des probablement premiers
+    mpz_t nb_to_check_prime;
+    mpz_init(nb_to_check_prime);
+    for (cl_uint i = 0; i < nb_candidats; i++)
+    {
+        if (cl_thread.resultats[i] == 0)
+            continue;
+        mpz_add_ui(nb_to_check_prime, bas, cl_thread.positions[i]);
+        if (mpz_probab_prime_p(nb_to_check_prime, 20) != 0)
+            push_result(parametre->outputList, nb_to_check_prime, parametre->inputNumeroThread);
+    }
+    mpz_clear(nb_to_check_prime);
+    STATS_TIMER_STOP(parametre->inputNumeroThread, ns_primality, debut_test);
+}
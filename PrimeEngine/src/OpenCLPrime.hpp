@@ -0,0 +1,23 @@
+#ifndef OPENCLPRIME_HPP
+#define OPENCLPRIME_HPP
+
+#include "Types.hpp"
+
+// Moteur OpenCL : les survivants du crible d'une fenêtre sont envoyés par lot au
+// noyau miller_rabin_128 (src/prime_mr.cl), un candidat de 128 bits par work-item.
+// Le noyau élimine les composés (un témoin de Miller-Rabin est une preuve) ; les
+// nombres qu'il déclare probablement premiers sont confirmés par GMP, si bien que
+// la sortie est identique à celle du moteur GMP. Les fenêtres non criblées ou qui
+// dépassent 2^128 sont traitées par compute_segment.
+//
+// N'est compilé que si CMake trouve OpenCL (WITH_OPENCL défini).
+
+// Choisit la plateforme et le périphérique (CPU, ex. PoCL, ou GPU), compile le noyau
+// et crée une file de commandes et un noyau par thread. A appeler une fois avant de
+// lancer les threads ; retourne false si aucun périphérique n'est utilisable.
+bool opencl_init(int nb_threads, bool gpu);
+
+// Équivalent de compute_segment pour le moteur OpenCL.
+void compute_segment_opencl(chunk_t const &morceau, struct param_thread_t *parametre);
+
+#endif //OPENCLPRIME_HPP
@@ -0,0 +1,49 @@
+#include "Periodic.hpp"
+#include <time.h>
+
+static void *periodic_loop(void *arg)
+{
+    periodic_thread_t &periodique = *(periodic_thread_t *)arg;
+    pthread_mutex_lock(&periodique.lock);
+    while (!periodique.stop)
+    {
+        struct timespec echeance;
+        clock_gettime(CLOCK_REALTIME, &echeance);
+        long ns = echeance.tv_nsec + (long)((periodique.periode - (long)periodique.periode) * 1e9);
+        echeance.tv_sec += (time_t)periodique.periode + ns / 1000000000L;
+        echeance.tv_nsec = ns % 1000000000L;
+        pthread_cond_timedwait(&periodique.cond, &periodique.lock, &echeance);
+        if (periodique.stop && !periodique.appel_final)
+            break;
+        periodique.tache(periodique.argument);
+    }
+    pthread_mutex_unlock(&periodique.lock);
+    return NULL;
+}
+
+void periodic_start(periodic_thread_t &periodique, double periode, void (*tache)(void *), void *argument,
+                    bool appel_final)
+{
+    periodique.tache = tache;
+    periodique.argument = argument;
+    periodique.periode = periode;
+    periodique.appel_final = appel_final;
+    periodique.stop = false;
+    pthread_mutex_init(&periodique.lock, NULL);
+    pthread_cond_init(&periodique.cond, NULL);
+    periodique.actif = (pthread_create(&periodique.thread, NULL, periodic_loop, &periodique) == 0);
+}
+
+void periodic_stop(periodic_thread_t &periodique)
+{
+    if (!periodique.actif)
+        return;
+    pthread_mutex_lock(&periodique.lock);
+    periodique.stop = true;
+    pthread_cond_signal(&periodique.cond);
+    pthread_mutex_unlock(&periodique.lock);
+    pthread_join(periodique.thread, NULL);
+    pthread_mutex_destroy(&periodique.lock);
+    pthread_cond_destroy(&periodique.cond);
+    periodique.actif = false;
+}
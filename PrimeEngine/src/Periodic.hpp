@@ -0,0 +1,29 @@
+#ifndef PERIODIC_HPP
+#define PERIODIC_HPP
+
+#include <pthread.h>
+
+// Thread de fond qui appelle tache(argument) toutes les periode secondes (attente
+// chronométrée sur une condition, pour que periodic_stop le réveille aussitôt).
+// Utilisé par l'échantillonnage de Stats.cpp et l'écriture des métriques de Metrics.cpp.
+typedef struct periodic_thread_t
+{
+  void (*tache)(void *);
+  void *argument;
+  double periode;
+  bool appel_final; // appeler tache une dernière fois à l'arrêt
+  bool actif;
+  bool stop;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+} periodic_thread_t;
+
+// Lance le thread ; periode doit être positive.
+void periodic_start(periodic_thread_t &periodique, double periode, void (*tache)(void *), void *argument,
+                    bool appel_final);
+
+// Réveille le thread et attend sa fin ; sans effet s'il n'est pas lancé.
+void periodic_stop(periodic_thread_t &periodique);
+
+#endif //PERIODIC_HPP
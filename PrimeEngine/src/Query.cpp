@@ -0,0 +1,144 @@
+#include "Query.hpp"
+#include "Stats.hpp"
+#include "AllocProfile.hpp"
+#include <math.h>
+#include <pthread.h>
+#include <map>
+#include <gmp.h>
+
+using namespace std;
+
+// État partagé d'une requête ; tout est protégé par lock.
+typedef struct requete_t
+{
+  pthread_mutex_t lock;
+  pthread_cond_t avance;                                // prochaine_a_valider a avancé ou termine
+  Custom_mpz_t prochain_bas;                             // début de la prochaine fenêtre
+  unsigned long taille_fenetre;
+  unsigned long nb_voulus;
+  unsigned long prochaine_fenetre;                      // prochaine fenêtre à distribuer
+  unsigned long prochaine_a_valider;                    // prochaine fenêtre à ajouter au résultat
+  unsigned long avance_max;                             // fenêtres distribuées au plus au-delà
+  bool termine;                                         // K nombres premiers validés
+  map<unsigned long, vector<Custom_mpz_t> > en_avance;  // fenêtres finies hors ordre
+  vector<Custom_mpz_t> *premiers;
+  void (*calcul_fenetre)(chunk_t const &, struct param_thread_t *);
+} requete_t;
+
+typedef struct param_requete_t
+{
+  requete_t *requete;
+  param_thread_t thread;
+} param_requete_t;
+
+unsigned long query_window_size(mpz_srcptr x, unsigned long nb_voulus, int nb_threads)
+{
+    //ln x = ln(d) + e ln 2 avec x = d * 2^e
+    signed long exposant;
+    double mantisse = mpz_get_d_2exp(&exposant, x);
+    double ln_x = (mpz_cmp_ui(x, 2) < 0) ? 1.0 : log(mantisse) + exposant * M_LN2;
+    double etendue = nb_voulus * (ln_x > 1.0 ? ln_x : 1.0);
+    double taille = etendue / (QUERY_WINDOWS_PER_THREAD * (nb_threads > 0 ? nb_threads : 1));
+    if (taille < QUERY_MIN_WINDOW)
+        return QUERY_MIN_WINDOW;
+    if (taille > QUERY_MAX_WINDOW)
+        return QUERY_MAX_WINDOW;
+    return (unsigned long)taille;
+}
+
+// Ajoute au résultat les fenêtres finies qui suivent la dernière validée ; appelé avec
+// requete->lock verrouillé.
+static void valider_fenetres(requete_t *requete)
+{
+    map<unsigned long, vector<Custom_mpz_t> >::iterator suivante;
+    while (!requete->termine &&
+           (suivante = requete->en_avance.find(requete->prochaine_a_valider)) != requete->en_avance.end())
+    {
+        vector<Custom_mpz_t> &fenetre = suivante->second;
+        for (size_t i = 0; i < fenetre.size() && requete->premiers->size() < requete->nb_voulus; i++)
+            requete->premiers->push_back(std::move(fenetre[i]));
+        requete->en_avance.erase(suivante);
+        requete->prochaine_a_valider++;
+        requete->termine = requete->premiers->size() >= requete->nb_voulus;
+        pthread_cond_broadcast(&requete->avance);
+    }
+}
+
+static void *next_primes_thread(void *arg)
+{
+    param_requete_t *parametre = (param_requete_t *)arg;
+    requete_t *requete = parametre->requete;
+    chunk_t fenetre;
+
+    while (true)
+    {
+        STATS_TIMER_START(debut_attente);
+        pthread_mutex_lock(&requete->lock);
+        //pas plus de avance_max fenêtres au-delà de la dernière validée : une fenêtre lente
+        //ne laisse pas les autres threads accumuler des résultats dans en_avance
+        while (!requete->termine && requete->prochaine_fenetre >= requete->prochaine_a_valider + requete->avance_max)
+            pthread_cond_wait(&requete->avance, &requete->lock);
+        STATS_TIMER_STOP(parametre->thread.inputNumeroThread, ns_lock_wait, debut_attente);
+        if (requete->termine)
+        {
+            pthread_mutex_unlock(&requete->lock);
+            break;
+        }
+        fenetre.id = requete->prochaine_fenetre++;
+        mpz_set(fenetre.intervalle.intervalle_bas.value, requete->prochain_bas.value);
+        mpz_add_ui(requete->prochain_bas.value, requete->prochain_bas.value, requete->taille_fenetre);
+        pthread_mutex_unlock(&requete->lock);
+
+        fenetre.num_intervalle = 0;
+        mpz_add_ui(fenetre.intervalle.intervalle_haut.value, fenetre.intervalle.intervalle_bas.value, requete->taille_fenetre);
+
+        STATS_ADD(parametre->thread.inputNumeroThread, chunks_stolen, 1);
+        parametre->thread.outputList.clear();
+        requete->calcul_fenetre(fenetre, &parametre->thread);
+
+        pthread_mutex_lock(&requete->lock);
+        if (!requete->termine) //sinon la fenêtre est au-delà du K-ième et ne sert plus
+        {
+            requete->en_avance[fenetre.id].swap(parametre->thread.outputList);
+            valider_fenetres(requete);
+        }
+        pthread_mutex_unlock(&requete->lock);
+    }
+    pthread_exit(NULL);
+}
+
+void next_primes(mpz_srcptr x, unsigned long nb_voulus, int nb_threads, unsigned long taille_fenetre,
+                 void (*calcul_fenetre)(chunk_t const &, struct param_thread_t *),
+                 vector<Custom_mpz_t> &premiers)
+{
+    ALLOC_PHASE("compute");
+    requete_t requete;
+    pthread_mutex_init(&requete.lock, NULL);
+    pthread_cond_init(&requete.avance, NULL);
+    mpz_set(requete.prochain_bas.value, x);
+    if (mpz_sgn(requete.prochain_bas.value) < 0)
+        mpz_set_ui(requete.prochain_bas.value, 0);
+    requete.taille_fenetre = taille_fenetre;
+    requete.nb_voulus = nb_voulus;
+    requete.prochaine_fenetre = 0;
+    requete.prochaine_a_valider = 0;
+    requete.avance_max = QUERY_MAX_AHEAD_PER_THREAD * (unsigned long)(nb_threads > 0 ? nb_threads : 1);
+    requete.termine = (nb_voulus == 0);
+    requete.premiers = &premiers;
+    requete.calcul_fenetre = calcul_fenetre;
+    premiers.clear();
+    premiers.reserve(nb_voulus < QUERY_MAX_WINDOW ? nb_voulus : QUERY_MAX_WINDOW);
+
+    pthread_t Ids_threads[nb_threads];
+    param_requete_t params_threads[nb_threads];
+    for (int i = 0; i < nb_threads; i++)
+    {
+        params_threads[i].requete = &requete;
+        params_threads[i].thread.inputNumeroThread = i;
+        pthread_create(&Ids_threads[i], NULL, next_primes_thread, (void *)&(params_threads[i]));
+    }
+    for (int i = 0; i < nb_threads; i++)
+        pthread_join(Ids_threads[i], NULL);
+    pthread_cond_destroy(&requete.avance);
+    pthread_mutex_destroy(&requete.lock);
+}
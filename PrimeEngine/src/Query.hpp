@@ -0,0 +1,30 @@
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include "Types.hpp"
+#include <vector>
+
+// Requête "les K premiers nombres premiers >= x". Les threads calculent en avance des
+// fenêtres consécutives [x + j*taille, x + (j+1)*taille) ; les résultats sont validés
+// dans l'ordre des fenêtres et la distribution s'arrête dès que K nombres premiers
+// sont validés. Les fenêtres calculées au-delà sont abandonnées.
+// Au plus QUERY_MAX_AHEAD_PER_THREAD fenêtres par thread sont distribuées au-delà de
+// la dernière fenêtre validée : la mémoire des résultats en avance reste bornée même
+// si une fenêtre est beaucoup plus lente que les autres.
+#define QUERY_MAX_AHEAD_PER_THREAD 2
+
+// Taille de fenêtre tirée de la densité 1/ln x : l'étendue attendue K*ln(x) est
+// découpée en environ QUERY_WINDOWS_PER_THREAD fenêtres par thread, pour que le
+// travail spéculatif perdu reste une petite fraction de l'étendue utile.
+#define QUERY_WINDOWS_PER_THREAD 4
+#define QUERY_MIN_WINDOW 1024
+#define QUERY_MAX_WINDOW (1UL << 20)
+unsigned long query_window_size(mpz_srcptr x, unsigned long nb_voulus, int nb_threads);
+
+// Remplit premiers avec les nb_voulus premiers nombres premiers >= x, dans l'ordre.
+// calcul_fenetre est le moteur utilisé pour chaque fenêtre (compute_segment, ...).
+void next_primes(mpz_srcptr x, unsigned long nb_voulus, int nb_threads, unsigned long taille_fenetre,
+                 void (*calcul_fenetre)(chunk_t const &, struct param_thread_t *),
+                 std::vector<Custom_mpz_t> &premiers);
+
+#endif //QUERY_HPP
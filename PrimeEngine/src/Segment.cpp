@@ -0,0 +1,98 @@
+#include "Segment.hpp"
+#include <algorithm>
+#include <gmp.h>
+
+void segment_begin(segment_iterator_t &iterateur, vect_of_intervalles_t const &intervalles, unsigned long taille_fenetre,
+                   size_t num_debut, size_t num_fin)
+{
+    iterateur.intervalles = &intervalles;
+    iterateur.num_intervalle = num_debut;
+    iterateur.fin_intervalles = num_fin;
+    iterateur.taille_fenetre = taille_fenetre;
+    iterateur.prochain_id = 0;
+    if (num_debut < num_fin)
+        mpz_set(iterateur.bas.value, intervalles.at(num_debut).intervalle_bas.value);
+}
+
+void segment_begin(segment_iterator_t &iterateur, vect_of_intervalles_t const &intervalles, unsigned long taille_fenetre)
+{
+    segment_begin(iterateur, intervalles, taille_fenetre, 0, intervalles.size());
+}
+
+bool segment_next(segment_iterator_t &iterateur, chunk_t &morceau)
+{
+    while (iterateur.num_intervalle < iterateur.fin_intervalles)
+    {
+        interval_t const &intervalle = iterateur.intervalles->at(iterateur.num_intervalle);
+        if (mpz_cmp(iterateur.bas.value, intervalle.intervalle_haut.value) < 0)
+        {
+            //la borne haute de la fenêtre ne dépasse pas celle de l'intervalle
+            mpz_set(morceau.intervalle.intervalle_bas.value, iterateur.bas.value);
+            mpz_add_ui(morceau.intervalle.intervalle_haut.value, iterateur.bas.value, iterateur.taille_fenetre);
+            if (mpz_cmp(morceau.intervalle.intervalle_haut.value, intervalle.intervalle_haut.value) > 0)
+                mpz_set(morceau.intervalle.intervalle_haut.value, intervalle.intervalle_haut.value);
+            morceau.id = iterateur.prochain_id++;
+            morceau.num_intervalle = iterateur.num_intervalle;
+            mpz_set(iterateur.bas.value, morceau.intervalle.intervalle_haut.value);
+            return true;
+        }
+        //intervalle terminé : passe au suivant
+        iterateur.num_intervalle++;
+        if (iterateur.num_intervalle < iterateur.fin_intervalles)
+            mpz_set(iterateur.bas.value, iterateur.intervalles->at(iterateur.num_intervalle).intervalle_bas.value);
+    }
+    return false;
+}
+
+bool segment_count(vect_of_intervalles_t const &intervalles, unsigned long taille_fenetre,
+                   std::vector<unsigned long> &premiers_morceaux, unsigned long &nb_morceaux)
+{
+    mpz_t largeur, total;
+    mpz_init(largeur);
+    mpz_init(total);
+    bool direct = true;
+    premiers_morceaux.resize(intervalles.size());
+    for (size_t i = 0; i < intervalles.size() && direct; i++)
+    {
+        premiers_morceaux[i] = mpz_get_ui(total);
+        //ceil((haut - bas) / taille), nul pour un intervalle vide
+        mpz_sub(largeur, intervalles[i].intervalle_haut.value, intervalles[i].intervalle_bas.value);
+        if (mpz_sgn(largeur) > 0)
+        {
+            mpz_cdiv_q_ui(largeur, largeur, taille_fenetre);
+            mpz_add(total, total, largeur);
+            direct = mpz_fits_ulong_p(total);
+        }
+    }
+    nb_morceaux = direct ? mpz_get_ui(total) : 0;
+    mpz_clear(largeur);
+    mpz_clear(total);
+    return direct;
+}
+
+void segment_at(vect_of_intervalles_t const &intervalles, std::vector<unsigned long> const &premiers_morceaux,
+                unsigned long taille_fenetre, unsigned long id, chunk_t &morceau)
+{
+    //dernier intervalle qui commence au plus tard à id (les intervalles vides qui le
+    //précèdent ont la même première fenêtre)
+    size_t num = std::upper_bound(premiers_morceaux.begin(), premiers_morceaux.end(), id) - premiers_morceaux.begin() - 1;
+    interval_t const &intervalle = intervalles[num];
+    mpz_set_ui(morceau.intervalle.intervalle_bas.value, id - premiers_morceaux[num]);
+    mpz_mul_ui(morceau.intervalle.intervalle_bas.value, morceau.intervalle.intervalle_bas.value, taille_fenetre);
+    mpz_add(morceau.intervalle.intervalle_bas.value, morceau.intervalle.intervalle_bas.value, intervalle.intervalle_bas.value);
+    mpz_add_ui(morceau.intervalle.intervalle_haut.value, morceau.intervalle.intervalle_bas.value, taille_fenetre);
+    if (mpz_cmp(morceau.intervalle.intervalle_haut.value, intervalle.intervalle_haut.value) > 0)
+        mpz_set(morceau.intervalle.intervalle_haut.value, intervalle.intervalle_haut.value);
+    morceau.id = id;
+    morceau.num_intervalle = num;
+}
+
+unsigned long chunk_width(chunk_t const &morceau)
+{
+    mpz_t largeur;
+    mpz_init(largeur);
+    mpz_sub(largeur, morceau.intervalle.intervalle_haut.value, morceau.intervalle.intervalle_bas.value);
+    unsigned long resultat = mpz_get_ui(largeur);
+    mpz_clear(largeur);
+    return resultat;
+}
@@ -0,0 +1,47 @@
+#ifndef SEGMENT_HPP
+#define SEGMENT_HPP
+
+#include "Types.hpp"
+
+// Itérateur de fenêtres : parcourt des intervalles triés et élagués par fenêtres
+// [bas, haut) d'au plus taille_fenetre nombres, sans jamais convertir la largeur
+// d'un intervalle en entier machine. L'état est constant en mémoire, quelle que
+// soit la largeur (des centaines de chiffres) des intervalles.
+// Les fenêtres sont numérotées dans l'ordre de parcours : pour les mêmes
+// intervalles et la même taille de fenêtre, une fenêtre a toujours le même id.
+typedef struct segment_iterator_t
+{
+  vect_of_intervalles_t const *intervalles;
+  size_t num_intervalle;      // intervalle en cours
+  size_t fin_intervalles;     // un après le dernier intervalle à parcourir
+  Custom_mpz_t bas;           // début de la prochaine fenêtre
+  unsigned long taille_fenetre;
+  unsigned long prochain_id;
+} segment_iterator_t;
+
+// Place l'itérateur au début des intervalles [num_debut, num_fin).
+void segment_begin(segment_iterator_t &iterateur, vect_of_intervalles_t const &intervalles, unsigned long taille_fenetre,
+                   size_t num_debut, size_t num_fin);
+
+// Place l'itérateur au début de tous les intervalles.
+void segment_begin(segment_iterator_t &iterateur, vect_of_intervalles_t const &intervalles, unsigned long taille_fenetre);
+
+// Écrit la prochaine fenêtre dans morceau (sans réallouer ses bornes) ;
+// retourne false quand tous les intervalles ont été parcourus.
+bool segment_next(segment_iterator_t &iterateur, chunk_t &morceau);
+
+// Accès direct : premiers_morceaux[i] reçoit l'id de la première fenêtre de
+// l'intervalle i, nb_morceaux le nombre total de fenêtres (mêmes id que segment_next).
+// Retourne false si ce nombre ne tient pas dans un unsigned long : seul le parcours
+// par segment_next reste alors possible.
+bool segment_count(vect_of_intervalles_t const &intervalles, unsigned long taille_fenetre,
+                   std::vector<unsigned long> &premiers_morceaux, unsigned long &nb_morceaux);
+
+// Écrit dans morceau la fenêtre d'identifiant id (id < segment_count(...)).
+void segment_at(vect_of_intervalles_t const &intervalles, std::vector<unsigned long> const &premiers_morceaux,
+                unsigned long taille_fenetre, unsigned long id, chunk_t &morceau);
+
+// Largeur d'une fenêtre ; tient toujours dans un unsigned long.
+unsigned long chunk_width(chunk_t const &morceau);
+
+#endif //SEGMENT_HPP
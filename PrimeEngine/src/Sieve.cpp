@@ -0,0 +1,79 @@
+#include "Sieve.hpp"
+#include "Segment.hpp"
+#include "Compute.hpp"
+#include "Stats.hpp"
+#include <gmp.h>
+
+using namespace std;
+
+static_assert(GMP_NUMB_BITS == 64, "les tables de Barrett supposent des limbs de 64 bits");
+
+// Tables générées à la compilation (voir SieveTables.hpp)
+static constexpr auto gPetitsPremiers = make_small_primes<SIEVE_LIMIT, WHEEL_MODULUS>();
+static constexpr auto gRoue = make_wheel<WHEEL_MODULUS>(); //1 si le résidu est premier avec 210
+static constexpr small_prime_t gModuleRoue = make_small_prime(WHEEL_MODULUS);
+
+small_prime_t const *sieve_primes(size_t &nb_premiers)
+{
+    nb_premiers = gPetitsPremiers.size();
+    return gPetitsPremiers.data();
+}
+
+bool sieve_window(chunk_t const &morceau, vector<unsigned char> &crible)
+{
+    mpz_srcptr bas = morceau.intervalle.intervalle_bas.value;
+    unsigned long largeur = chunk_width(morceau);
+    crible.assign(largeur, 1);
+
+    //Le crible n'est valable que si aucun nombre de la fenêtre n'est lui-même un
+    //petit premier. Les fenêtres proches de zéro sont testées sans crible.
+    if (mpz_cmp_ui(bas, SIEVE_LIMIT) > 0)
+    {
+        //les restes sont calculés directement sur les mots de bas (Barrett, sans division)
+        uint64_t const *mots = (uint64_t const *)mpz_limbs_read(bas);
+        size_t nb_mots = mpz_size(bas);
+
+        //roue : recopie le motif des résidus modulo 210
+        unsigned long residu = mod_small(mots, nb_mots, gModuleRoue);
+        for (unsigned long k = 0; k < largeur; k++)
+        {
+            crible[k] = gRoue[residu];
+            if (++residu == WHEEL_MODULUS)
+                residu = 0;
+        }
+        //petits premiers : premier multiple de p dans la fenêtre, puis pas de p
+        for (size_t i = 0; i < gPetitsPremiers.size(); i++)
+        {
+            unsigned long p = gPetitsPremiers[i].p;
+            unsigned long reste = mod_small(mots, nb_mots, gPetitsPremiers[i]);
+            for (unsigned long k = (reste == 0) ? 0 : p - reste; k < largeur; k += p)
+                crible[k] = 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+void compute_segment(chunk_t const &morceau, struct param_thread_t *parametre)
+{
+    mpz_srcptr bas = morceau.intervalle.intervalle_bas.value;
+    unsigned long largeur = chunk_width(morceau);
+    vector<unsigned char> &crible = parametre->crible;
+    sieve_window(morceau, crible);
+
+    mpz_t nb_to_check_prime;
+    mpz_init(nb_to_check_prime);
+    for (unsigned long k = 0; k < largeur; k++)
+    {
+        if (crible[k] == 0)
+            continue;
+        mpz_add_ui(nb_to_check_prime, bas, k);
+        STATS_TIMER_START(debut_test);
+        int is_prime = mpz_probab_prime_p(nb_to_check_prime, 20); //determine if nb is prime. probability of error < 4^(-20)
+        STATS_TIMER_STOP(parametre->inputNumeroThread, ns_primality, debut_test);
+        STATS_ADD(parametre->inputNumeroThread, candidates, 1);
+        if (is_prime == 1 || is_prime == 2)                       //number is certainly prime or probably prime
+            push_result(parametre->outputList, nb_to_check_prime, parametre->inputNumeroThread);
+    }
+    mpz_clear(nb_to_check_prime);
+}
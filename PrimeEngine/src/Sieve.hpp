@@ -0,0 +1,29 @@
+#ifndef SIEVE_HPP
+#define SIEVE_HPP
+
+#include "Types.hpp"
+#include "SieveTables.hpp"
+#include <vector>
+
+// Crible par fenêtre : avant le test de Miller-Rabin, les multiples des petits
+// premiers sont éliminés de la fenêtre. Les multiples de 2, 3, 5 et 7 sont retirés
+// d'un coup en recopiant le motif de la roue de période 210 ; les premiers de 11
+// à SIEVE_LIMIT sont ensuite criblés un par un.
+#define SIEVE_LIMIT 16384
+#define WHEEL_MODULUS 210
+
+// Petits premiers de 11 à SIEVE_LIMIT avec leurs constantes de Barrett ; la table est
+// calculée à la compilation, il n'y a rien à initialiser.
+small_prime_t const *sieve_primes(size_t &nb_premiers);
+
+// Remplit crible (une case par nombre de la fenêtre) : 0 si le nombre a un petit
+// facteur premier, 1 sinon. Retourne false si la fenêtre est trop proche de zéro
+// pour être criblée (toutes les cases restent à 1).
+bool sieve_window(chunk_t const &morceau, std::vector<unsigned char> &crible);
+
+// Calcule les nombres premiers de la fenêtre morceau et les ajoute à la liste du
+// thread. Seul le tampon parametre->crible (une case par nombre de la fenêtre) est
+// alloué, et il est réutilisé d'une fenêtre à l'autre.
+void compute_segment(chunk_t const &morceau, struct param_thread_t *parametre);
+
+#endif //SIEVE_HPP
@@ -0,0 +1,94 @@
+#ifndef SIEVETABLES_HPP
+#define SIEVETABLES_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+
+// Tables du crible calculées à la compilation (constexpr) et placées en données en
+// lecture seule : aucun calcul au démarrage, quelle que soit leur taille.
+
+// Petit premier p et ses constantes de réduction de Barrett :
+//   r64     = 2^64 mod p, pour réduire un nombre de plusieurs mots de 64 bits par Horner ;
+//   barrett = floor((2^64 - 1) / p), x mod p = x - mulhi(x, barrett) * p (à p près).
+typedef struct small_prime_t
+{
+  uint32_t p;
+  uint32_t r64;
+  uint64_t barrett;
+} small_prime_t;
+
+constexpr bool is_small_prime(uint32_t n)
+{
+    if (n < 2)
+        return false;
+    for (uint32_t d = 2; d * d <= n; d++)
+        if (n % d == 0)
+            return false;
+    return true;
+}
+
+// Premiers de 2 à limite qui ne divisent pas le module de la roue (ceux-là sont
+// éliminés par le motif de la roue).
+constexpr size_t count_small_primes(uint32_t limite, uint32_t module_roue)
+{
+    size_t nb = 0;
+    for (uint32_t n = 2; n <= limite; n++)
+        if (is_small_prime(n) && module_roue % n != 0)
+            nb++;
+    return nb;
+}
+
+constexpr small_prime_t make_small_prime(uint32_t p)
+{
+    return small_prime_t{p, (uint32_t)((UINT64_MAX % p + 1) % p), UINT64_MAX / p};
+}
+
+template <uint32_t Limite, uint32_t ModuleRoue>
+constexpr std::array<small_prime_t, count_small_primes(Limite, ModuleRoue)> make_small_primes()
+{
+    std::array<small_prime_t, count_small_primes(Limite, ModuleRoue)> table{};
+    size_t i = 0;
+    for (uint32_t n = 2; n <= Limite; n++)
+        if (is_small_prime(n) && ModuleRoue % n != 0)
+            table[i++] = make_small_prime(n);
+    return table;
+}
+
+// Motif de la roue : 1 si le résidu est premier avec le module.
+template <uint32_t ModuleRoue>
+constexpr std::array<unsigned char, ModuleRoue> make_wheel()
+{
+    std::array<unsigned char, ModuleRoue> roue{};
+    for (uint32_t r = 0; r < ModuleRoue; r++)
+    {
+        uint32_t a = r, b = ModuleRoue;
+        while (b != 0)
+        {
+            uint32_t t = a % b;
+            a = b;
+            b = t;
+        }
+        roue[r] = (a == 1);
+    }
+    return roue;
+}
+
+// x mod p par Barrett, sans division.
+inline uint64_t barrett_mod(uint64_t x, small_prime_t const &premier)
+{
+    uint64_t q = (uint64_t)(((unsigned __int128)x * premier.barrett) >> 64);
+    uint64_t r = x - q * premier.p;
+    return (r >= premier.p) ? r - premier.p : r;
+}
+
+// Reste de la division d'un nombre de nb_mots mots de 64 bits (poids faible en premier) par p.
+inline uint32_t mod_small(uint64_t const *mots, size_t nb_mots, small_prime_t const &premier)
+{
+    uint64_t r = 0;
+    for (size_t i = nb_mots; i-- > 0;)
+        r = barrett_mod(r * premier.r64 + barrett_mod(mots[i], premier), premier);
+    return (uint32_t)r;
+}
+
+#endif //SIEVETABLES_HPP
@@ -0,0 +1,96 @@
+#include "Stats.hpp"
+#include "Periodic.hpp"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static thread_stats_t gStats[STATS_MAX_THREADS];
+static int gNbThreadsStats = 0;
+static uint64_t gDebutStats = 0;
+
+// Échantillonnage sur stderr toutes les gPeriodeStats secondes.
+static double gPeriodeStats = 1.0;
+static periodic_thread_t gSampler = periodic_thread_t();
+
+thread_stats_t *stats_thread(int numero_thread)
+{
+    assert(numero_thread >= 0 && numero_thread < STATS_MAX_THREADS);
+    return &gStats[numero_thread];
+}
+
+// Additionne les compteurs de tous les threads.
+static void stats_total(uint64_t total[6])
+{
+    for (int k = 0; k < 6; k++)
+        total[k] = 0;
+    for (int i = 0; i < gNbThreadsStats; i++)
+    {
+        total[0] += gStats[i].candidates.load(std::memory_order_relaxed);
+        total[1] += gStats[i].primes.load(std::memory_order_relaxed);
+        total[2] += gStats[i].ns_primality.load(std::memory_order_relaxed);
+        total[3] += gStats[i].ns_lock_wait.load(std::memory_order_relaxed);
+        total[4] += gStats[i].chunks_stolen.load(std::memory_order_relaxed);
+        total[5] += gStats[i].bytes_allocated.load(std::memory_order_relaxed);
+    }
+}
+
+static void stats_sample(void *)
+{
+    uint64_t total[6];
+    stats_total(total);
+    double secondes = (stats_now_ns() - gDebutStats) * 1e-9;
+    fprintf(stderr, "[stats %.1fs] testes=%llu premiers=%llu primalite=%.3fs attente_verrou=%.3fs morceaux=%llu octets=%llu\n",
+            secondes, (unsigned long long)total[0], (unsigned long long)total[1], total[2] * 1e-9,
+            total[3] * 1e-9, (unsigned long long)total[4], (unsigned long long)total[5]);
+}
+
+void stats_init(int nb_threads)
+{
+    gNbThreadsStats = nb_threads < STATS_MAX_THREADS ? nb_threads : STATS_MAX_THREADS;
+    gDebutStats = stats_now_ns();
+    atexit(stats_finish);
+
+    const char *periode = getenv("STATS_PERIOD");
+    if (periode != NULL)
+        gPeriodeStats = atof(periode);
+    if (gPeriodeStats > 0)
+        periodic_start(gSampler, gPeriodeStats, stats_sample, NULL, false);
+}
+
+void stats_finish(void)
+{
+    periodic_stop(gSampler);
+    if (gNbThreadsStats == 0)
+        return;
+
+    const char *chemin = getenv("STATS_JSON");
+    FILE *fichier = fopen(chemin != NULL ? chemin : "stats.json", "w");
+    if (fichier == NULL)
+    {
+        perror("stats_finish");
+        return;
+    }
+    uint64_t total[6];
+    stats_total(total);
+    fprintf(fichier, "{\n  \"duree_ns\": %llu,\n  \"threads\": [\n", (unsigned long long)(stats_now_ns() - gDebutStats));
+    for (int i = 0; i < gNbThreadsStats; i++)
+    {
+        fprintf(fichier, "    {\"thread\": %d, \"candidates\": %llu, \"primes\": %llu, \"ns_primality\": %llu, "
+                         "\"ns_lock_wait\": %llu, \"chunks_stolen\": %llu, \"bytes_allocated\": %llu}%s\n",
+                i,
+                (unsigned long long)gStats[i].candidates.load(),
+                (unsigned long long)gStats[i].primes.load(),
+                (unsigned long long)gStats[i].ns_primality.load(),
+                (unsigned long long)gStats[i].ns_lock_wait.load(),
+                (unsigned long long)gStats[i].chunks_stolen.load(),
+                (unsigned long long)gStats[i].bytes_allocated.load(),
+                (i + 1 < gNbThreadsStats) ? "," : "");
+    }
+    fprintf(fichier, "  ],\n  \"total\": {\"candidates\": %llu, \"primes\": %llu, \"ns_primality\": %llu, "
+                     "\"ns_lock_wait\": %llu, \"chunks_stolen\": %llu, \"bytes_allocated\": %llu}\n}\n",
+            (unsigned long long)total[0], (unsigned long long)total[1], (unsigned long long)total[2],
+            (unsigned long long)total[3], (unsigned long long)total[4], (unsigned long long)total[5]);
+    fclose(fichier);
+    // écrit une seule fois, même si stats_finish est aussi appelé explicitement
+    gNbThreadsStats = 0;
+}
@@ -0,0 +1,68 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Instrumentation du moteur : compteurs par thread (nombres testés, premiers
+// trouvés, temps de test de primalité, attente sur les verrous, morceaux pris
+// dans la file partagée, octets alloués).
+// Activée seulement si le projet est configuré avec -DENABLE_STATS=ON ; sinon
+// toutes les macros STATS_* disparaissent à la compilation.
+//
+// A l'exécution :
+//   STATS_JSON=<fichier>    fichier JSON écrit à la sortie (défaut : stats.json)
+//   STATS_PERIOD=<secondes> période d'échantillonnage sur stderr (0 = aucun, défaut : 1)
+
+#define STATS_MAX_THREADS 256
+
+// Un seul thread écrit dans sa case (le thread propriétaire) ; le thread
+// d'échantillonnage ne fait que lire. Chaque case occupe sa propre ligne de
+// cache pour éviter le faux partage.
+typedef struct alignas(64) thread_stats_t
+{
+  std::atomic<uint64_t> candidates;      // nombres passés au test de primalité
+  std::atomic<uint64_t> primes;          // nombres premiers trouvés
+  std::atomic<uint64_t> ns_primality;    // temps passé dans mpz_probab_prime_p
+  std::atomic<uint64_t> ns_lock_wait;    // attente sur gLock ou omp critical
+  std::atomic<uint64_t> chunks_stolen;   // morceaux de travail pris dans la file partagée
+  std::atomic<uint64_t> bytes_allocated; // octets alloués pour les résultats
+} thread_stats_t;
+
+// Initialise les compteurs, lance l'échantillonnage et enregistre l'écriture
+// du JSON à la sortie du programme.
+void stats_init(int nb_threads);
+
+// Arrête l'échantillonnage et écrit le JSON (appelé automatiquement par atexit).
+void stats_finish(void);
+
+// Retourne la case de compteurs du thread numero_thread.
+thread_stats_t *stats_thread(int numero_thread);
+
+inline uint64_t stats_now_ns(void)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Ajout sans instruction atomique : le thread propriétaire est le seul écrivain.
+inline void stats_add(std::atomic<uint64_t> &counter, uint64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+#ifdef ENABLE_STATS
+#define STATS_INIT(nb_threads) stats_init(nb_threads)
+#define STATS_ADD(thread, field, value) stats_add(stats_thread(thread)->field, (value))
+#define STATS_TIMER_START(name) uint64_t name = stats_now_ns()
+#define STATS_TIMER_STOP(thread, field, name) STATS_ADD(thread, field, stats_now_ns() - name)
+#else
+#define STATS_INIT(nb_threads) ((void)0)
+#define STATS_ADD(thread, field, value) ((void)0)
+#define STATS_TIMER_START(name) ((void)0)
+#define STATS_TIMER_STOP(thread, field, name) ((void)0)
+#endif
+
+#endif //STATS_HPP
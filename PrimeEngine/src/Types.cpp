@@ -15,13 +15,19 @@ Custom_mpz_t::Custom_mpz_t(mpz_t const &op)
 }
 Custom_mpz_t::Custom_mpz_t(unsigned int op)
 {
-    mpz_inits(value);
+    mpz_init(value);
     mpz_set_ui(value, op);
 }
-// Custom_mpz_t::~Custom_mpz_t(void)
-// {
-//     mpz_clear(value);
-// }
+// Le déplacement échange les limbs au lieu de les copier (std::vector, std::sort)
+Custom_mpz_t::Custom_mpz_t(Custom_mpz_t &&other) noexcept
+{
+    mpz_init(value);
+    mpz_swap(value, other.value);
+}
+Custom_mpz_t::~Custom_mpz_t(void)
+{
+    mpz_clear(value);
+}
 Custom_mpz_t &Custom_mpz_t::operator=(Custom_mpz_t const &other)
 {
     if ((void *)this == (void *)&other)
@@ -30,6 +36,12 @@ Custom_mpz_t &Custom_mpz_t::operator=(Custom_mpz_t const &other)
     return *this;
 }
 
+Custom_mpz_t &Custom_mpz_t::operator=(Custom_mpz_t &&other) noexcept
+{
+    mpz_swap(value, other.value);
+    return *this;
+}
+
 Custom_mpz_t Custom_mpz_t::operator-(Custom_mpz_t const &op1)
 {
     Custom_mpz_t res;
@@ -54,12 +66,6 @@ Custom_mpz_t Custom_mpz_t::operator+(unsigned int op2)
     mpz_add_ui(res.value, value, op2);
     return res;
 }
-Custom_mpz_t Custom_mpz_t::operator+(int op2)
-{
-    Custom_mpz_t res;
-    mpz_add_ui(res.value, value, (unsigned int)op2);
-    return res;
-}
 bool Custom_mpz_t::operator==(Custom_mpz_t const &op2)
 {
     if (mpz_cmp(value, op2.value) == 0)
@@ -11,13 +11,15 @@ public:
   Custom_mpz_t(Custom_mpz_t const &other);
   Custom_mpz_t(mpz_t const &op);
   Custom_mpz_t(unsigned int op);
+  Custom_mpz_t(Custom_mpz_t &&other) noexcept;
+  ~Custom_mpz_t(void);
 
   Custom_mpz_t &operator=(Custom_mpz_t const &other);
+  Custom_mpz_t &operator=(Custom_mpz_t &&other) noexcept;
   Custom_mpz_t operator-(Custom_mpz_t const &op1);
   Custom_mpz_t operator-(unsigned int op2);
   Custom_mpz_t operator+(Custom_mpz_t const &op1);
   Custom_mpz_t operator+(unsigned int op2);
-  Custom_mpz_t operator+(int op2);
 
   bool operator==(Custom_mpz_t const &op2);
   bool operator>(const Custom_mpz_t &op2);
@@ -33,6 +35,16 @@ typedef struct interval_t
 } interval_t;
 typedef std::vector<interval_t> vect_of_intervalles_t;
 
+// Morceau de travail (fenêtre) : sous-intervalle [bas, haut) d'au plus taille_morceau
+// nombres. L'identifiant est le rang du morceau dans le plan, stable d'une exécution
+// à l'autre tant que les intervalles élagués et la taille des morceaux sont les mêmes.
+typedef struct chunk_t
+{
+  unsigned long id;
+  size_t num_intervalle; //intervalle d'où vient le morceau
+  interval_t intervalle;
+} chunk_t;
+
 typedef struct param_thread
 {
   int inputNumeroThread;
@@ -45,6 +57,8 @@ typedef struct param_thread_t
   int inputNumeroThread;
   vect_of_intervalles_t intervalle;
   std::vector<Custom_mpz_t> outputList;
+  std::vector<unsigned char> crible; //tampon du crible, réutilisé d'une fenêtre à l'autre
+  std::vector<std::vector<Custom_mpz_t> > sorties; //résultats par fichier d'entrée (mode lot)
 } param_thread_t;
 
 #endif
@@ -0,0 +1,190 @@
+#include <stdio.h>
+#include <climits>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <gmp.h>
+#include <string>
+#include <gmpxx.h>
+#include "Types.hpp"
+#include "Chrono.hpp"
+#include "Stats.hpp"
+#include "Metrics.hpp"
+#include "Sieve.hpp"
+#include "Engine.hpp"
+#include "Query.hpp"
+#ifdef WITH_OPENCL
+#include "OpenCLPrime.hpp"
+#endif
+using namespace std;
+
+#define TAILLE_MORCEAU_DEFAUT 4096
+
+int main(int argc, char *argv[])
+{
+    // Vérifie le nombre d'arguments
+    if (argc <= 2)
+    {
+        cerr << "Usage : " << argv[0] << " <nb_threads> <fichier>... [--manifest <liste.txt>] [--chunk <taille>]"
+             << " [--backend auto|seq|pthreads|openmp|stealing] [--primality gmp|opencl-cpu|opencl-gpu]"
+             << " [--checkpoint <journal>] [--checkpoint-interval <secondes>] [--resume] [--metrics <fichier>]\n"
+             << "        " << argv[0] << " <nb_threads> --next <x> <K> [--chunk <taille>] [--primality ...]\n";
+        return EXIT_FAILURE;
+    }
+
+    // Fichiers et options
+    engine_options_t options;
+    options.nb_threads = atoi(argv[1]);
+    options.backend = BACKEND_AUTO;
+    options.calcul_fenetre = compute_segment;
+    options.chemin_journal = NULL;
+    options.intervalle_journal = 10.0;
+    options.reprise = false;
+    options.chemin_metriques = NULL;
+    vector<string> fichiers;
+    unsigned long taille_morceau = TAILLE_MORCEAU_DEFAUT;
+    string moteur = "gmp";
+    bool requete = false; //--next : les K premiers nombres premiers >= x
+    mpz_class depart;
+    unsigned long nb_voulus = 0;
+    bool taille_imposee = false;
+    bool lot = false; //plusieurs fichiers : une sortie <fichier>.premiers par fichier
+    for (int i = 2; i < argc; i++)
+    {
+        string option = argv[i];
+        if (option == "--chunk" && i + 1 < argc)
+        {
+            taille_morceau = strtoul(argv[++i], NULL, 10);
+            taille_imposee = true;
+        }
+        else if (option == "--next" && i + 2 < argc)
+        {
+            requete = (depart.set_str(argv[i + 1], 10) == 0);
+            nb_voulus = strtoul(argv[i + 2], NULL, 10);
+            i += 2;
+            if (!requete)
+            {
+                cerr << "Nombre invalide : " << argv[i - 1] << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+        else if (option == "--backend" && i + 1 < argc)
+        {
+            if (!backend_parse(argv[++i], options.backend))
+            {
+                cerr << "Stratégie inconnue : " << argv[i] << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+        else if (option == "--primality" && i + 1 < argc)
+            moteur = argv[++i];
+        else if (option == "--checkpoint" && i + 1 < argc)
+            options.chemin_journal = argv[++i];
+        else if (option == "--checkpoint-interval" && i + 1 < argc)
+            options.intervalle_journal = atof(argv[++i]);
+        else if (option == "--metrics" && i + 1 < argc)
+            options.chemin_metriques = argv[++i];
+        else if (option == "--resume")
+            options.reprise = true;
+        else if (option == "--manifest" && i + 1 < argc)
+        {
+            //un fichier d'intervalles par ligne
+            ifstream manifeste(argv[++i]);
+            if (manifeste.is_open() == 0)
+            {
+                cerr << "Impossible d'ouvrir le manifeste " << argv[i] << ".\n";
+                return EXIT_FAILURE;
+            }
+            string ligne;
+            while (getline(manifeste, ligne))
+                if (!ligne.empty())
+                    fichiers.push_back(ligne);
+            lot = true;
+        }
+        else if (option.compare(0, 2, "--") == 0)
+        {
+            cerr << "Option inconnue : " << option << "\n";
+            return EXIT_FAILURE;
+        }
+        else
+            fichiers.push_back(option);
+    }
+    lot = lot || fichiers.size() > 1;
+    if (requete && (!fichiers.empty() || options.chemin_journal != NULL || options.chemin_metriques != NULL))
+    {
+        cerr << "--next ne se combine ni avec des fichiers ni avec --checkpoint ou --metrics.\n";
+        return EXIT_FAILURE;
+    }
+    if ((!requete && fichiers.empty()) || taille_morceau == 0 || options.nb_threads <= 0 ||
+        (options.reprise && options.chemin_journal == NULL))
+    {
+        cerr << "Il faut au moins un fichier et un thread, --chunk doit être positif et --resume demande --checkpoint.\n";
+        return EXIT_FAILURE;
+    }
+    // une case de compteurs par thread, écrite par lui seul : pas plus de threads que de cases
+    if (options.chemin_metriques != NULL && options.nb_threads > METRICS_MAX_THREADS)
+    {
+        cerr << "--metrics suit au plus " << METRICS_MAX_THREADS << " threads.\n";
+        return EXIT_FAILURE;
+    }
+#ifdef ENABLE_STATS
+    if (options.nb_threads > STATS_MAX_THREADS)
+    {
+        cerr << "ENABLE_STATS suit au plus " << STATS_MAX_THREADS << " threads.\n";
+        return EXIT_FAILURE;
+    }
+#endif
+
+    if (moteur == "opencl-cpu" || moteur == "opencl-gpu")
+    {
+#ifdef WITH_OPENCL
+        if (!opencl_init(options.nb_threads, moteur == "opencl-gpu"))
+            return EXIT_FAILURE;
+        options.calcul_fenetre = compute_segment_opencl;
+#else
+        cerr << "Ce programme a été compilé sans OpenCL.\n";
+        return EXIT_FAILURE;
+#endif
+    }
+    else if (moteur != "gmp")
+    {
+        cerr << "Moteur inconnu : " << moteur << "\n";
+        return EXIT_FAILURE;
+    }
+
+    STATS_INIT(options.nb_threads);
+    Chrono chron = Chrono();
+
+    if (requete)
+    {
+        unsigned long taille_fenetre = taille_imposee ? taille_morceau : query_window_size(depart.get_mpz_t(), nb_voulus, options.nb_threads);
+        vector<Custom_mpz_t> premiers;
+        float tic = chron.get();
+        next_primes(depart.get_mpz_t(), nb_voulus, options.nb_threads, taille_fenetre, options.calcul_fenetre, premiers);
+        float tac = chron.get();
+        for (size_t i = 0; i < premiers.size(); i++)
+            cout << premiers[i].value << '\n';
+        cerr << "temps d'execution : " << tac - tic << " secondes (fenetres de " << taille_fenetre << ")" << endl;
+        return EXIT_SUCCESS;
+    }
+
+    //debut du traitement des intervalles; début du chronometre
+    float tic = chron.get();
+    engine_plan_t plan;
+    vector<vector<Custom_mpz_t> > resultats;
+    if (!engine_plan(fichiers, taille_morceau, plan) || !engine_execute(plan, options, resultats))
+        return EXIT_FAILURE;
+    //traitement des intervalles terminé; fin du chronometre
+    float tac = chron.get();
+
+    engine_emit(plan, resultats, lot);
+
+    //affichage du temps d'execution dans stderr
+    cerr << "temps d'execution : " << tac - tic << " secondes (" << backend_name(engine_backend(plan, options)) << ", ";
+    if (plan.acces_direct)
+        cerr << plan.nb_morceaux << " fenetres)" << endl;
+    else
+        cerr << "plus de " << ULONG_MAX << " fenetres)" << endl;
+
+    return EXIT_SUCCESS;
+}
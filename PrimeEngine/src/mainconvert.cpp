@@ -0,0 +1,35 @@
+#include <iostream>
+#include "Types.hpp"
+#include "Compute.hpp"
+#include "IntervalFile.hpp"
+using namespace std;
+
+// Normalise une fois pour toutes un fichier d'intervalles texte : les exécutions
+// suivantes du moteur lisent le fichier binaire sans analyse, ni tri, ni élagage.
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        cerr << "Usage : " << argv[0] << " <fichier.txt> <fichier.bin>\n";
+        return EXIT_FAILURE;
+    }
+
+    vect_of_intervalles_t intervalles;
+    if (!read_intervalles_texte(argv[1], intervalles))
+    {
+        cerr << "Impossible d'ouvrir le fichier " << argv[1] << ".\n";
+        return EXIT_FAILURE;
+    }
+    if (!intervalles.empty())
+    {
+        swap_intervalle(intervalles);
+        sort_and_prune(intervalles);
+    }
+    if (!interval_file_write(argv[2], intervalles))
+    {
+        cerr << "Impossible d'écrire le fichier " << argv[2] << ".\n";
+        return EXIT_FAILURE;
+    }
+    cerr << argv[2] << " : " << intervalles.size() << " intervalles normalisés" << endl;
+    return EXIT_SUCCESS;
+}
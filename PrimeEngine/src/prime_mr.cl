@@ -0,0 +1,156 @@
+// Test de Miller-Rabin sur des candidats de 128 bits, un candidat par work-item.
+// Un nombre n est représenté par deux mots de 64 bits (x = bas, y = haut) ; les
+// multiplications modulaires se font en représentation de Montgomery (R = 2^128)
+// par l'algorithme CIOS sur deux mots. Les candidats doivent être impairs et
+// supérieurs aux bases testées (le crible de l'hôte le garantit).
+// resultats[i] = 0 si candidats[i] est composé (certain), 1 s'il est probablement premier.
+
+#define NB_BASES_MAX 12
+__constant ulong BASES[NB_BASES_MAX] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+// t + a*b + c sur 128 bits ; retourne le mot bas et place le mot haut dans *retenue.
+inline ulong mac(ulong t, ulong a, ulong b, ulong c, ulong *retenue)
+{
+    ulong bas = a * b;
+    ulong haut = mul_hi(a, b);
+    bas += t;
+    haut += (bas < t);
+    bas += c;
+    haut += (bas < c);
+    *retenue = haut;
+    return bas;
+}
+
+inline int ge128(ulong2 a, ulong2 b)
+{
+    return (a.y > b.y) || (a.y == b.y && a.x >= b.x);
+}
+
+inline ulong2 sub128(ulong2 a, ulong2 b)
+{
+    ulong2 r;
+    r.x = a.x - b.x;
+    r.y = a.y - b.y - (a.x < b.x);
+    return r;
+}
+
+// (2a) mod n pour a < n
+inline ulong2 double_mod(ulong2 a, ulong2 n)
+{
+    ulong debordement = a.y >> 63;
+    ulong2 r;
+    r.x = a.x << 1;
+    r.y = (a.y << 1) | (a.x >> 63);
+    if (debordement || ge128(r, n))
+        r = sub128(r, n);
+    return r;
+}
+
+// a * b * R^-1 mod n (CIOS, deux mots) ; n_inv = -n^-1 mod 2^64
+inline ulong2 mont_mul(ulong2 a, ulong2 b, ulong2 n, ulong n_inv)
+{
+    ulong t0 = 0, t1 = 0, t2 = 0, t3, c, m;
+    ulong bi[2] = {b.x, b.y};
+    for (int i = 0; i < 2; i++)
+    {
+        // t += a * b[i]
+        t0 = mac(t0, a.x, bi[i], 0, &c);
+        t1 = mac(t1, a.y, bi[i], c, &c);
+        t2 += c;
+        t3 = (t2 < c);
+        // t = (t + m*n) / 2^64
+        m = t0 * n_inv;
+        mac(t0, m, n.x, 0, &c);
+        t0 = mac(t1, m, n.y, c, &c);
+        t1 = t2 + c;
+        t2 = t3 + (t1 < c);
+    }
+    ulong2 r = (ulong2)(t0, t1);
+    if (t2 || ge128(r, n))
+        r = sub128(r, n);
+    return r;
+}
+
+__kernel void miller_rabin_128(__global const ulong2 *candidats, __global uchar *resultats, const uint nb_candidats,
+                               const uint nb_bases)
+{
+    uint id = get_global_id(0);
+    if (id >= nb_candidats)
+        return;
+    ulong2 n = candidats[id];
+
+    // -n^-1 mod 2^64 par Newton (n impair) : chaque itération double les bits exacts
+    ulong inv = n.x;
+    for (int k = 0; k < 6; k++)
+        inv *= 2 - n.x * inv;
+    ulong n_inv = -inv;
+
+    // R mod n par 128 doublements de 1, puis -1 en représentation de Montgomery
+    ulong2 un = (ulong2)(1, 0);
+    for (int k = 0; k < 128; k++)
+        un = double_mod(un, n);
+    ulong2 moins_un = sub128(n, un);
+
+    // n - 1 = d * 2^s avec d impair
+    ulong2 d = (ulong2)(n.x - 1, n.y);
+    uint s = 0;
+    while (d.x == 0)
+    {
+        d.x = d.y;
+        d.y = 0;
+        s += 64;
+    }
+    // zéros de poids faible (ctz n'existe qu'en OpenCL C 2.0)
+    uint z = (uint)popcount((d.x & -d.x) - 1);
+    if (z > 0)
+    {
+        d.x = (d.x >> z) | (d.y << (64 - z));
+        d.y >>= z;
+        s += z;
+    }
+
+    for (uint b = 0; b < nb_bases && b < NB_BASES_MAX; b++)
+    {
+        // base a en représentation de Montgomery : a * R mod n par doublements
+        ulong2 a = (ulong2)(0, 0);
+        for (int bit = 6; bit >= 0; bit--)
+        {
+            a = double_mod(a, n);
+            if ((BASES[b] >> bit) & 1)
+            {
+                ulong2 somme = (ulong2)(a.x + un.x, a.y + un.y + (a.x + un.x < a.x));
+                int debordement = (somme.y < a.y) || (somme.y == a.y && somme.x < a.x);
+                a = (debordement || ge128(somme, n)) ? sub128(somme, n) : somme;
+            }
+        }
+
+        // x = a^d mod n, exponentiation de gauche à droite
+        ulong2 x = un;
+        for (int bit = 127; bit >= 0; bit--)
+        {
+            x = mont_mul(x, x, n, n_inv);
+            ulong mot = (bit >= 64) ? d.y : d.x;
+            if ((mot >> (bit & 63)) & 1)
+                x = mont_mul(x, a, n, n_inv);
+        }
+        if ((x.x == un.x && x.y == un.y) || (x.x == moins_un.x && x.y == moins_un.y))
+            continue;
+
+        int temoin = 1;
+        for (uint r = 1; r < s; r++)
+        {
+            x = mont_mul(x, x, n, n_inv);
+            if (x.x == moins_un.x && x.y == moins_un.y)
+            {
+                temoin = 0;
+                break;
+            }
+        }
+        if (temoin)
+        {
+            resultats[id] = 0;
+            return;
+        }
+    }
+    resultats[id] = 1;
+}
@@ -0,0 +1,116 @@
+# Comparer une fonctionnalite du moteur au chemin texte (primes 2 <entree>, sortie standard) :
+#   cmake -DPRIMES=<primes> -DCONVERT=<primes_convert> -DENTREE=<intervalles.txt> -DSORTIE=<dossier>
+#         -DMODE=<mode> -P compare_text.cmake
+# Modes :
+#   resume : journal coupe au milieu d'une ligne, avec une ligne corrompue avant, puis --resume ;
+#            puis journal vide
+#   binary : fichier converti au format binaire par primes_convert, et intervalles de meme
+#            borne inferieure
+#   next   : pour les premiers intervalles d'au moins 2 nombres premiers p1 < ... < pK,
+#            --next p1 K doit donner exactement p1 ... pK
+#   opencl : test de primalite OpenCL sur CPU (--primality opencl-cpu, ex. PoCL)
+
+# Executer primes avec les arguments suivants ; sa sortie standard dans la variable sortie.
+function(run_primes sortie)
+    execute_process(COMMAND ${PRIMES} ${ARGN} OUTPUT_VARIABLE texte ERROR_VARIABLE erreurs RESULT_VARIABLE code)
+    if (NOT code EQUAL 0)
+        string(REPLACE ";" " " arguments "${ARGN}")
+        message(FATAL_ERROR "primes ${arguments} : code ${code}\n${erreurs}")
+    endif()
+    set(${sortie} "${texte}" PARENT_SCOPE)
+endfunction()
+
+# Echouer si obtenu differe de la reference.
+function(check_same nom obtenu)
+    if (NOT obtenu STREQUAL reference)
+        file(WRITE ${SORTIE}/${nom}.txt "${obtenu}")
+        file(WRITE ${SORTIE}/${nom}_reference.txt "${reference}")
+        message(FATAL_ERROR "${nom} : sortie differente du chemin texte (${SORTIE}/${nom}.txt)")
+    endif()
+endfunction()
+
+run_primes(reference 2 ${ENTREE})
+
+if (MODE STREQUAL "resume")
+    set(journal ${SORTIE}/resume.ckpt)
+    file(REMOVE ${journal})
+    run_primes(complet 2 ${ENTREE} --chunk 1000 --checkpoint ${journal})
+    check_same(checkpoint "${complet}")
+
+    # en-tete, une ligne corrompue, la moitie des morceaux et une ligne incomplete
+    file(STRINGS ${journal} lignes)
+    list(LENGTH lignes nb_lignes)
+    set(nb_lignes_complet ${nb_lignes})
+    math(EXPR moitie "${nb_lignes} / 2")
+    list(GET lignes 0 entete)
+    set(contenu "${entete}\n")
+    foreach(i RANGE 1 ${moitie})
+        list(GET lignes ${i} ligne)
+        if (i EQUAL 3)
+            set(ligne "corrompue")
+        endif()
+        string(APPEND contenu "${ligne}\n")
+    endforeach()
+    math(EXPR nb_lignes "${nb_lignes} - 1")
+    list(GET lignes ${nb_lignes} derniere)
+    string(SUBSTRING "${derniere}" 0 5 debut)
+    string(APPEND contenu "${debut}")
+    file(WRITE ${journal} "${contenu}")
+
+    run_primes(repris 2 ${ENTREE} --chunk 1000 --checkpoint ${journal} --resume)
+    check_same(resume "${repris}")
+    # la ligne corrompue et tout ce qui la suit ont ete remplaces : une ligne par morceau
+    file(STRINGS ${journal} lignes)
+    list(LENGTH lignes nb_lignes)
+    if (NOT nb_lignes EQUAL nb_lignes_complet)
+        message(FATAL_ERROR "journal repris : ${nb_lignes} lignes au lieu de ${nb_lignes_complet}")
+    endif()
+    # le journal complete par la reprise suffit a une seconde reprise
+    run_primes(repris 2 ${ENTREE} --chunk 1000 --checkpoint ${journal} --resume)
+    check_same(resume_again "${repris}")
+    # journal vide (arret avant l'ecriture de l'en-tete) : rien a reprendre
+    file(WRITE ${journal} "")
+    run_primes(repris 2 ${ENTREE} --chunk 1000 --checkpoint ${journal} --resume)
+    check_same(resume_empty "${repris}")
+elseif (MODE STREQUAL "binary")
+    # Convertir texte en binaire puis comparer la sortie de primes sur les deux fichiers.
+    function(check_binary nom texte)
+        execute_process(COMMAND ${CONVERT} ${texte} ${SORTIE}/${nom}.bin ERROR_VARIABLE erreurs RESULT_VARIABLE code)
+        if (NOT code EQUAL 0)
+            message(FATAL_ERROR "primes_convert ${texte} : code ${code}\n${erreurs}")
+        endif()
+        run_primes(binaire 2 ${SORTIE}/${nom}.bin)
+        check_same(${nom} "${binaire}")
+    endfunction()
+    check_binary(binary ${ENTREE})
+
+    # intervalles de meme borne inferieure : l'elagage ne doit pas en laisser un a l'envers
+    file(WRITE ${SORTIE}/chevauchements.txt "5 5\n5 10\n20000 20000\n20000 20100\n")
+    run_primes(reference 2 ${SORTIE}/chevauchements.txt)
+    check_binary(binary_overlaps ${SORTIE}/chevauchements.txt)
+elseif (MODE STREQUAL "next")
+    file(STRINGS ${ENTREE} intervalles)
+    set(nb_testes 0)
+    foreach(intervalle ${intervalles})
+        if (nb_testes LESS 5)
+            file(WRITE ${SORTIE}/intervalle.txt "${intervalle}\n")
+            run_primes(reference 2 ${SORTIE}/intervalle.txt)
+            string(REGEX MATCHALL "[0-9]+" premiers "${reference}")
+            list(LENGTH premiers nb_premiers)
+            if (nb_premiers GREATER 1)
+                list(GET premiers 0 depart)
+                run_primes(suivants 2 --next ${depart} ${nb_premiers})
+                check_same(next "${suivants}")
+                math(EXPR nb_testes "${nb_testes} + 1")
+            endif()
+        endif()
+    endforeach()
+    if (nb_testes EQUAL 0)
+        message(FATAL_ERROR "aucun intervalle de ${ENTREE} ne contient 2 nombres premiers")
+    endif()
+elseif (MODE STREQUAL "opencl")
+    run_primes(opencl 2 ${ENTREE} --primality opencl-cpu)
+    check_same(opencl "${opencl}")
+else()
+    message(FATAL_ERROR "Mode inconnu : ${MODE}")
+endif()
@@ -0,0 +1,821 @@
+//
+//  Invert.cpp
+//
+
+#include "Invert.hpp"
+#include "Gemm.hpp"
+#include "Parallel.hpp"
+#include "Verify.hpp"
+#include "AllocProfile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+// Inverser la matrice par la méthode de Gauss-Jordan; implantation séquentielle.
+// Par rangées, pour tout type d'éléments (double ou float).
+template <typename T>
+void invertSequential(BasicMatrix<T, RowMajor> &iA)
+{
+
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    // construire la matrice [A I]
+    BasicMatrixConcatCols<T> lAI(iA, BasicMatrixIdentity<T>(iA.rows()));
+
+    // traiter chaque rangée
+    for (size_t k = 0; k < iA.rows(); ++k)
+    {
+        ALLOC_PHASE("pivot");
+        // trouver l'index p du plus grand pivot de la colonne k en valeur absolue
+        // (pour une meilleure stabilité numérique).
+        size_t p = k;
+        T lMax = fabs(lAI(k, k));
+        for (size_t i = k; i < lAI.rows(); ++i)
+        {
+            if (fabs(lAI(i, k)) > lMax)
+            {
+                lMax = fabs(lAI(i, k));
+                p = i;
+            }
+        }
+        // vérifier que la matrice n'est pas singulière
+        if (lAI(p, k) == 0)
+            throw runtime_error("Matrix not invertible");
+
+        // échanger la ligne courante avec celle du pivot
+        if (p != k)
+            lAI.swapRows(p, k);
+
+        // On divise les éléments de la rangée k
+        // par la valeur du pivot.
+        // Ainsi, lAI(k,k) deviendra égal à 1.
+        T lValue = lAI(k, k);
+        lAI.getRow(k) /= lValue;
+
+        // Pour chaque rangée (réparties entre les threads de la bibliothèque)...
+        ALLOC_PHASE("eliminate");
+        parallelFor(0, lAI.rows(), [&](size_t i) {
+            if (i != k)
+            { // ...différente de k
+                // On soustrait la rangée k
+                // multipliée par l'élément k de la rangée courante
+                T lValue = lAI(i, k);
+                lAI.getRow(i) -= lAI.getRow(k) * lValue;
+            }
+        }, lAI.cols());
+    }
+
+    // On copie la partie droite de la matrice AI ainsi transformée
+    // dans la matrice courante (this).
+    iA.getBlock() = lAI.getBlock(0, iA.cols(), iA.rows(), iA.cols());
+}
+
+// Par colonnes : les rangées contiguës de la vue transposée sont les colonnes de A, et
+// inv(A^T) = inv(A)^T. On inverse donc A^T par rangées et le résultat, relu par
+// colonnes, est inv(A). Les copies sont ligne à ligne, contiguës des deux côtés.
+template <typename T>
+void invertSequential(BasicMatrix<T, ColMajor> &iA)
+{
+    BasicMatrix<T, RowMajor> lAt(iA.cols(), iA.rows());
+    lAt.getBlock() = iA.getBlock().transpose();
+    invertSequential(lAt);
+    iA.getBlock().transpose() = lAt.getBlock();
+}
+
+// Gauss-Jordan sur place, par rangées : iA devient son inverse, sans la copie [A I].
+// Au pas k, la colonne k de A (qui deviendrait celle de I) reçoit la colonne k de
+// l'inverse : chaque pas ne touche que n colonnes au lieu de 2n. Les échanges de
+// rangées de A sont des échanges de colonnes de l'inverse, défaits à la fin.
+template <typename T>
+static void invertInPlaceRows(const BasicBlockView<T> &iA)
+{
+    size_t n = iA.rows();
+    // lPerm[k] : rangée échangée avec la rangée k au pas k
+    vector<size_t> lPerm(n);
+
+    // traiter chaque rangée
+    for (size_t k = 0; k < n; ++k)
+    {
+        ALLOC_PHASE("pivot");
+        // trouver l'index p du plus grand pivot de la colonne k en valeur absolue
+        size_t p = k;
+        T lMax = fabs(iA(k, k));
+        for (size_t i = k; i < n; ++i)
+        {
+            if (fabs(iA(i, k)) > lMax)
+            {
+                lMax = fabs(iA(i, k));
+                p = i;
+            }
+        }
+        // vérifier que la matrice n'est pas singulière
+        if (iA(p, k) == 0)
+            throw runtime_error("Matrix not invertible");
+
+        // échanger la ligne courante avec celle du pivot
+        lPerm[k] = p;
+        if (p != k)
+            swap_ranges(iA.getRow(p).begin(), iA.getRow(p).end(), iA.getRow(k).begin());
+
+        // diviser la rangée k par le pivot; la case (k, k) reçoit 1 / pivot
+        T lValue = iA(k, k);
+        iA(k, k) = 1;
+        iA.getRow(k) /= lValue;
+
+        // éliminer la colonne k des autres rangées; la case (i, k) reçoit -A(i, k) / pivot
+        ALLOC_PHASE("eliminate");
+        parallelFor(0, n, [&](size_t i) {
+            if (i != k)
+            {
+                T lValue = iA(i, k);
+                iA(i, k) = 0;
+                iA.getRow(i) -= iA.getRow(k) * lValue;
+            }
+        }, n);
+    }
+
+    // défaire les échanges, du dernier au premier, sur les colonnes
+    for (size_t k = n; k-- > 0;)
+        if (lPerm[k] != k)
+            for (size_t i = 0; i < n; ++i)
+                std::swap(iA(i, k), iA(i, lPerm[k]));
+}
+
+// Inverser la matrice sur place, par rangées.
+template <typename T>
+void invertInPlace(BasicMatrix<T, RowMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    invertInPlaceRows(iA.getBlock());
+}
+
+// Par colonnes : inverser A^T sur place, par rangées, comme pour invertSequential.
+template <typename T>
+void invertInPlace(BasicMatrix<T, ColMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    invertInPlaceRows(iA.getBlock().transpose());
+}
+
+// Plus grand pivot trouvé par un thread dans ses rangées : valeur absolue et rangée.
+template <typename T>
+struct PivotCandidate
+{
+    T mValeur;
+    size_t mRangee;
+};
+
+// Gauss-Jordan sur place réparti entre les threads, sans échange de rangées : le pivot de
+// la colonne k est la rangée oPerm[k], qui contient à la fin la rangée k de inv(P A).
+// Chaque thread possède une tranche fixe de rangées; à chaque pivot, il cherche le
+// maximum de la colonne suivante dans ses rangées en même temps qu'il les élimine, et la
+// réduction des candidats est refaite par chaque thread après l'unique barrière du pas.
+// Chaque thread élimine avec sa propre copie normalisée de la rangée pivot; la rangée
+// pivot elle-même n'est réécrite par son propriétaire qu'au pas suivant, quand plus aucun
+// thread ne la lit. Retourne faux si la matrice est singulière.
+template <typename T>
+static bool eliminateThreaded(const BasicBlockView<T> &iA, vector<size_t> &oPerm)
+{
+    size_t n = iA.rows();
+    int lMaxThreads = getMatrixThreads();
+    BasicMatrix<T> lPivots(lMaxThreads, n);
+    // candidats des colonnes paires puis impaires : ceux du pas suivant sont écrits
+    // pendant que d'autres threads lisent encore ceux du pas courant
+    vector<PivotCandidate<T> > lCandidats(2 * lMaxThreads);
+    vector<char> lUtilisee(n, 0);
+    bool lSinguliere = false;
+
+    parallelRegion([&](int iThread, int iThreads) {
+        size_t lDebut = n * iThread / iThreads, lFin = n * (iThread + 1) / iThreads;
+        BasicRowView<T> lPivot = lPivots.getRow(iThread);
+        size_t lEnAttente = n;
+
+        // candidat de la colonne 0
+        PivotCandidate<T> lCandidat = {0, n};
+        for (size_t i = lDebut; i < lFin; ++i)
+            if (fabs(iA(i, 0)) > lCandidat.mValeur)
+                lCandidat = {fabs(iA(i, 0)), i};
+        lCandidats[iThread] = lCandidat;
+        parallelBarrier();
+
+        for (size_t k = 0; k < n; ++k)
+        {
+            // réduction des candidats, dans l'ordre des rangées
+            const PivotCandidate<T> *lDuPas = &lCandidats[(k % 2) * lMaxThreads];
+            size_t p = n;
+            T lMax = 0;
+            for (int t = 0; t < iThreads; ++t)
+                if (lDuPas[t].mValeur > lMax)
+                {
+                    lMax = lDuPas[t].mValeur;
+                    p = lDuPas[t].mRangee;
+                }
+            // vérifier que la matrice n'est pas singulière (même décision dans tous les threads)
+            if (p == n)
+            {
+                if (iThread == 0)
+                    lSinguliere = true;
+                break;
+            }
+
+            // rangée pivot du pas précédent, plus lue par personne
+            if (lEnAttente < n)
+                iA.getRow(lEnAttente) = lPivot;
+            lEnAttente = n;
+
+            // copie normalisée de la rangée pivot : A(p,k) remplacé par 1, puis divisé
+            T lInverse = 1 / iA(p, k);
+            lPivot = iA.getRow(p) * lInverse;
+            lPivot[k] = lInverse;
+            if (p >= lDebut && p < lFin)
+            {
+                oPerm[k] = p;
+                lUtilisee[p] = 1;
+                lEnAttente = p;
+            }
+
+            // éliminer la colonne k des rangées du thread, chercher le pivot de la colonne k + 1
+            lCandidat = {0, n};
+            for (size_t i = lDebut; i < lFin; ++i)
+            {
+                if (i == p)
+                    continue;
+                T l = iA(i, k);
+                if (l != 0)
+                {
+                    iA(i, k) = 0;
+                    iA.getRow(i) -= lPivot * l;
+                }
+                if (k + 1 < n && !lUtilisee[i] && fabs(iA(i, k + 1)) > lCandidat.mValeur)
+                    lCandidat = {fabs(iA(i, k + 1)), i};
+            }
+            lCandidats[((k + 1) % 2) * lMaxThreads + iThread] = lCandidat;
+            parallelBarrier();
+        }
+        if (lEnAttente < n)
+            iA.getRow(lEnAttente) = lPivot;
+    });
+    return !lSinguliere;
+}
+
+// Inverser sur place avec eliminateThreaded, puis remettre en ordre : les rangées de
+// inv(P A) sont aux rangées oPerm, et inv(A) = inv(P A) P.
+template <typename T>
+static void invertThreadedRows(const BasicBlockView<T> &iA)
+{
+    size_t n = iA.rows();
+    vector<size_t> lPerm(n);
+    ALLOC_PHASE("eliminate");
+    if (!eliminateThreaded(iA, lPerm))
+        throw runtime_error("Matrix not invertible");
+
+    BasicMatrix<T> lCopie(n, n);
+    lCopie.getBlock() = iA;
+    parallelFor(0, n, [&](size_t r) {
+        for (size_t s = 0; s < n; ++s)
+            iA(r, lPerm[s]) = lCopie(lPerm[r], s);
+    }, n);
+}
+
+// Inverser la matrice par Gauss-Jordan multithread, par rangées.
+template <typename T>
+void invertThreaded(BasicMatrix<T, RowMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    invertThreadedRows(iA.getBlock());
+}
+
+// Par colonnes : inverser A^T sur place, par rangées, comme pour invertSequential.
+template <typename T>
+void invertThreaded(BasicMatrix<T, ColMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    invertThreadedRows(iA.getBlock().transpose());
+}
+
+// oB = L^-1 oB, L triangulaire inférieure à diagonale unité (TRSM à gauche). Les bandes
+// de colonnes de oB sont indépendantes : réparties entre les threads.
+template <typename T>
+static void solveLowerUnitLeft(const BasicBlockView<const T> &iL, const BasicBlockView<T> &oB)
+{
+    const size_t lBande = 256;
+    size_t lBandes = (oB.cols() + lBande - 1) / lBande;
+    parallelFor(0, lBandes, [&](size_t b) {
+        BasicBlockView<T> lB = oB.getBlock(0, b * lBande, oB.rows(), min(lBande, oB.cols() - b * lBande));
+        for (size_t i = 1; i < lB.rows(); ++i)
+            for (size_t p = 0; p < i; ++p)
+                lB.getRow(i) -= lB.getRow(p) * iL(i, p);
+    }, oB.rows() * oB.rows() * lBande);
+}
+
+// oB = U^-1 oB, U triangulaire supérieure (TRSM à gauche), même découpage que
+// solveLowerUnitLeft.
+template <typename T>
+static void solveUpperLeft(const BasicBlockView<const T> &iU, const BasicBlockView<T> &oB)
+{
+    const size_t lBande = 256;
+    size_t lBandes = (oB.cols() + lBande - 1) / lBande;
+    parallelFor(0, lBandes, [&](size_t b) {
+        BasicBlockView<T> lB = oB.getBlock(0, b * lBande, oB.rows(), min(lBande, oB.cols() - b * lBande));
+        for (size_t i = lB.rows(); i-- > 0;)
+        {
+            for (size_t p = i + 1; p < lB.rows(); ++p)
+                lB.getRow(i) -= lB.getRow(p) * iU(i, p);
+            lB.getRow(i) *= 1 / iU(i, i);
+        }
+    }, oB.rows() * oB.rows() * lBande);
+}
+
+// Échanger les rangées c et iPerm[c] de ioB, pour c de iDebut à iFin, dans l'ordre.
+template <typename T>
+static void swapRows(const BasicBlockView<T> &ioB, const size_t *iPerm, size_t iDebut, size_t iFin)
+{
+    for (size_t c = iDebut; c < iFin; ++c)
+        if (iPerm[c] != c)
+            swap_ranges(ioB.getRow(c).begin(), ioB.getRow(c).end(), ioB.getRow(iPerm[c]).begin());
+}
+
+// Factorisation LU d'un panneau m x w (m >= w) avec pivot partiel, récursive : moitié
+// gauche, mise à jour de la moitié droite (TRSM puis GEMM), moitié droite. oPerm[c] :
+// rangée du panneau échangée avec la rangée c; les échanges ne touchent que le panneau.
+// Retourne faux si une colonne n'a pas de pivot.
+template <typename T>
+static bool factorPanel(const BasicBlockView<T> &iP, size_t *oPerm)
+{
+    size_t m = iP.rows(), w = iP.cols();
+    if (w == 1)
+    {
+        size_t p = 0;
+        for (size_t i = 1; i < m; ++i)
+            if (fabs(iP(i, 0)) > fabs(iP(p, 0)))
+                p = i;
+        if (iP(p, 0) == 0)
+            return false;
+        oPerm[0] = p;
+        std::swap(iP(0, 0), iP(p, 0));
+        T lInverse = 1 / iP(0, 0);
+        for (size_t i = 1; i < m; ++i)
+            iP(i, 0) *= lInverse;
+        return true;
+    }
+
+    size_t w1 = w / 2;
+    BasicBlockView<T> lGauche = iP.getBlock(0, 0, m, w1), lDroite = iP.getBlock(0, w1, m, w - w1);
+    if (!factorPanel(lGauche, oPerm))
+        return false;
+    swapRows(lDroite, oPerm, 0, w1);
+    BasicBlockView<T> lU12 = lDroite.getBlock(0, 0, w1, w - w1);
+    solveLowerUnitLeft<T>(lGauche.getBlock(0, 0, w1, w1), lU12);
+    multiplyBlocks<T, RowMajor>(lGauche.getBlock(w1, 0, m - w1, w1), lU12, lDroite.getBlock(w1, 0, m - w1, w - w1), -1, 1);
+    if (!factorPanel(lDroite.getBlock(w1, 0, m - w1, w - w1), oPerm + w1))
+        return false;
+    // rangées du sous-panneau droit comptées depuis le haut du panneau
+    for (size_t c = w1; c < w; ++c)
+        oPerm[c] += w1;
+    swapRows(lGauche, oPerm, w1, w);
+    return true;
+}
+
+// Factorisation LU par blocs de colonnes (à la getrf), sur place : P A = L U, L à diagonale
+// unité sous la diagonale, U au-dessus. oPerm[j] : rangée échangée avec la rangée j.
+// Le panneau de INVERT_LU_BLOCK colonnes est factorisé rangée par rangée; le reste de la
+// matrice est mis à jour par GEMM, qui fait l'essentiel des opérations.
+template <typename T>
+static void factorLU(const BasicBlockView<T> &iA, vector<size_t> &oPerm)
+{
+    size_t n = iA.rows();
+    for (size_t j0 = 0; j0 < n; j0 += INVERT_LU_BLOCK)
+    {
+        size_t jb = min<size_t>(INVERT_LU_BLOCK, n - j0);
+
+        // panneau A[j0:n, j0:j0+jb], colonne par colonne
+        ALLOC_PHASE("pivot");
+        for (size_t j = j0; j < j0 + jb; ++j)
+        {
+            // plus grand pivot de la colonne j en valeur absolue
+            size_t p = j;
+            T lMax = fabs(iA(j, j));
+            for (size_t i = j + 1; i < n; ++i)
+            {
+                if (fabs(iA(i, j)) > lMax)
+                {
+                    lMax = fabs(iA(i, j));
+                    p = i;
+                }
+            }
+            // vérifier que la matrice n'est pas singulière
+            if (iA(p, j) == 0)
+                throw runtime_error("Matrix not invertible");
+
+            // échanger les rangées entières (L déjà calculé et partie non factorisée)
+            oPerm[j] = p;
+            if (p != j)
+                swap_ranges(iA.getRow(p).begin(), iA.getRow(p).end(), iA.getRow(j).begin());
+
+            // multiplicateurs de la colonne j et mise à jour du reste du panneau
+            T lPivot = iA(j, j);
+            BasicBlockView<T> lReste = iA.getBlock(0, j + 1, n, j0 + jb - j - 1);
+            parallelFor(j + 1, n, [&](size_t i) {
+                iA(i, j) /= lPivot;
+                lReste.getRow(i) -= lReste.getRow(j) * iA(i, j);
+            }, jb);
+        }
+        if (j0 + jb == n)
+            break;
+
+        // A12 = L11^-1 A12, puis A22 -= A21 A12
+        ALLOC_PHASE("eliminate");
+        size_t lReste = n - j0 - jb;
+        BasicBlockView<T> lA12 = iA.getBlock(j0, j0 + jb, jb, lReste);
+        solveLowerUnitLeft<T>(iA.getBlock(j0, j0, jb, jb), lA12);
+        multiplyBlocks<T, RowMajor>(iA.getBlock(j0 + jb, j0, lReste, jb), lA12,
+                                    iA.getBlock(j0 + jb, j0 + jb, lReste, lReste), -1, 1);
+    }
+}
+
+// Inverser sur place un bloc triangulaire supérieur, non bloqué (à la trti2). Seule la
+// partie supérieure (diagonale comprise) est lue et modifiée.
+template <typename T>
+static void invertUpperUnblocked(const BasicBlockView<T> &iU)
+{
+    for (size_t j = 0; j < iU.rows(); ++j)
+    {
+        iU(j, j) = 1 / iU(j, j);
+        T lFacteur = -iU(j, j);
+        // colonne j au-dessus de la diagonale : X[0:j, 0:j] (déjà inversé) * U[0:j, j];
+        // rangées croissantes, chacune ne lit que les suivantes
+        for (size_t i = 0; i < j; ++i)
+        {
+            T lSomme = 0;
+            for (size_t p = i; p < j; ++p)
+                lSomme += iU(i, p) * iU(p, j);
+            iU(i, j) = lSomme * lFacteur;
+        }
+    }
+}
+
+// Inverser sur place la partie triangulaire supérieure U de iA, par blocs de colonnes (à
+// la trtri) : la partie sous la diagonale (L) n'est ni lue ni modifiée. Pour le bloc de
+// colonnes j0, B = U[0:j0, j0:j0+jb] devient -X11 B inv(U22), où X11 est l'inverse déjà
+// calculé de U[0:j0, 0:j0]; X11 B est fait par GEMM hors des blocs diagonaux.
+template <typename T>
+static void invertUpper(const BasicBlockView<T> &iA)
+{
+    size_t n = iA.rows();
+    for (size_t j0 = 0; j0 < n; j0 += INVERT_LU_BLOCK)
+    {
+        size_t jb = min<size_t>(INVERT_LU_BLOCK, n - j0);
+        BasicBlockView<T> lB = iA.getBlock(0, j0, j0, jb);
+
+        // B = X11 B, par blocs de rangées croissants : le bloc r ne lit que les blocs
+        // suivants de B, pas encore modifiés
+        for (size_t r0 = 0; r0 < j0; r0 += INVERT_LU_BLOCK)
+        {
+            size_t rb = min<size_t>(INVERT_LU_BLOCK, j0 - r0);
+            BasicBlockView<T> lBr = lB.getBlock(r0, 0, rb, jb);
+            // bloc diagonal de X11 (triangulaire supérieur)
+            for (size_t i = 0; i < rb; ++i)
+            {
+                lBr.getRow(i) *= iA(r0 + i, r0 + i);
+                for (size_t p = i + 1; p < rb; ++p)
+                    lBr.getRow(i) += lBr.getRow(p) * iA(r0 + i, r0 + p);
+            }
+            // blocs de X11 à droite du bloc diagonal
+            if (r0 + rb < j0)
+                multiplyBlocks<T, RowMajor>(iA.getBlock(r0, r0 + rb, rb, j0 - r0 - rb),
+                                            lB.getBlock(r0 + rb, 0, j0 - r0 - rb, jb), lBr, 1, 1);
+        }
+
+        // B = -B inv(U22) (TRSM à droite), rangées indépendantes
+        BasicBlockView<T> lU22 = iA.getBlock(j0, j0, jb, jb);
+        parallelFor(0, j0, [&](size_t i) {
+            BasicRowView<T> lX = lB.getRow(i);
+            for (size_t c = 0; c < jb; ++c)
+            {
+                T lSomme = lX[c];
+                for (size_t d = 0; d < c; ++d)
+                    lSomme -= lX[d] * lU22(d, c);
+                lX[c] = lSomme / lU22(c, c);
+            }
+            lX *= -1;
+        }, jb * jb);
+
+        invertUpperUnblocked(lU22);
+    }
+}
+
+// Inverser A à partir de sa factorisation LU (à la getri) : X = inv(U) inv(L) est la
+// solution de X L = inv(U), calculée par blocs de colonnes de droite à gauche (GEMM pour
+// les colonnes déjà résolues, TRSM pour le bloc diagonal de L); inv(A) = X P.
+template <typename T>
+static void invertFromLU(const BasicBlockView<T> &iA, const vector<size_t> &iPerm)
+{
+    size_t n = iA.rows();
+    if (n == 0)
+        return;
+    invertUpper(iA);
+
+    // copie des colonnes de L du bloc courant
+    BasicMatrix<T> lW(n, INVERT_LU_BLOCK);
+    for (size_t j0 = (n - 1) / INVERT_LU_BLOCK * INVERT_LU_BLOCK;; j0 -= INVERT_LU_BLOCK)
+    {
+        size_t jb = min<size_t>(INVERT_LU_BLOCK, n - j0);
+        // W = L[:, j0:j0+jb] sous la diagonale, remplacé par 0 dans A
+        parallelFor(j0, n, [&](size_t i) {
+            for (size_t c = 0; c < jb; ++c)
+            {
+                if (i > j0 + c)
+                {
+                    lW(i, c) = iA(i, j0 + c);
+                    iA(i, j0 + c) = 0;
+                }
+                else
+                    lW(i, c) = 0;
+            }
+        }, jb);
+
+        // X[:, j0:j0+jb] -= X[:, j0+jb:n] W[j0+jb:n, :]
+        BasicBlockView<T> lXj = iA.getBlock(0, j0, n, jb);
+        if (j0 + jb < n)
+            multiplyBlocks<T, RowMajor>(iA.getBlock(0, j0 + jb, n, n - j0 - jb),
+                                        lW.getBlock(j0 + jb, 0, n - j0 - jb, jb), lXj, -1, 1);
+
+        // X[:, j0:j0+jb] = X[:, j0:j0+jb] inv(Wjj), Wjj triangulaire inférieure unité
+        parallelFor(0, n, [&](size_t i) {
+            BasicRowView<T> lX = lXj.getRow(i);
+            for (size_t c = jb; c-- > 0;)
+                for (size_t d = c + 1; d < jb; ++d)
+                    lX[c] -= lX[d] * lW(j0 + d, c);
+        }, jb * jb);
+
+        if (j0 == 0)
+            break;
+    }
+
+    // inv(A) = X P : défaire les échanges de rangées sur les colonnes, du dernier au premier
+    for (size_t j = n; j-- > 0;)
+        if (iPerm[j] != j)
+            for (size_t i = 0; i < n; ++i)
+                std::swap(iA(i, j), iA(i, iPerm[j]));
+}
+
+// Inverser la matrice par factorisation LU par blocs, par rangées.
+template <typename T>
+void invertLU(BasicMatrix<T, RowMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    vector<size_t> lPerm(iA.rows());
+    factorLU(iA.getBlock(), lPerm);
+    invertFromLU(iA.getBlock(), lPerm);
+}
+
+// Par colonnes : inverser A^T sur place, par rangées, comme pour invertSequential.
+template <typename T>
+void invertLU(BasicMatrix<T, ColMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    vector<size_t> lPerm(iA.rows());
+    factorLU(iA.getBlock().transpose(), lPerm);
+    invertFromLU(iA.getBlock().transpose(), lPerm);
+}
+
+// Inversion par tuiles de INVERT_TILE colonnes, en deux graphes de tâches.
+// 1. LU : tâche panneau(k) (factorPanel sur les rangées k nb .. n du bloc de colonnes k),
+//    puis pour chaque bloc j > k une tâche de mise à jour (échanges du panneau k, TRSM,
+//    GEMM sous le panneau) et pour chaque j < k une tâche d'échanges. Les dépendances
+//    portent sur les blocs de colonnes; le panneau et la mise à jour du bloc k + 1 sont
+//    prioritaires, de sorte que le panneau k + 1 démarre pendant les mises à jour du
+//    panneau k (anticipation).
+// 2. Une tâche indépendante par bloc de colonnes j de X : inv(L) (nul au-dessus de la
+//    rangée j nb) puis la remontée par U, par GEMM et TRSM; inv(A) = X P à la fin.
+template <typename T>
+static void invertTiledRows(const BasicBlockView<T> &iA)
+{
+    const size_t nb = INVERT_TILE;
+    size_t n = iA.rows(), nt = (n + nb - 1) / nb;
+    // lPerm[k nb + c] : rangée du panneau k échangée avec sa rangée c
+    vector<size_t> lPerm(n);
+    // objets des dépendances : blocs de colonnes de la LU, puis de X
+    vector<char> lColonnes(nt), lSolutions(nt);
+    // écrit par une tâche de panneau, lu par les tâches des autres colonnes
+    atomic<bool> lSinguliere(false);
+    auto lLargeur = [&](size_t j) { return min(nb, n - j * nb); };
+
+    ALLOC_PHASE("pivot");
+    parallelTasks([&]() {
+        for (size_t k = 0; k < nt; ++k)
+        {
+            size_t k0 = k * nb, kb = lLargeur(k);
+            spawnTask([&, k0, kb]() {
+                if (!lSinguliere.load(memory_order_relaxed) &&
+                    !factorPanel(iA.getBlock(k0, k0, n - k0, kb), &lPerm[k0]))
+                    lSinguliere.store(true, memory_order_relaxed);
+            }, NULL, &lColonnes[k], 2);
+
+            for (size_t j = k + 1; j < nt; ++j)
+                spawnTask([&, k0, kb, j]() {
+                    if (lSinguliere.load(memory_order_relaxed))
+                        return;
+                    size_t j0 = j * nb, jb = lLargeur(j);
+                    swapRows(iA.getBlock(k0, j0, n - k0, jb), &lPerm[k0], 0, kb);
+                    BasicBlockView<T> lUkj = iA.getBlock(k0, j0, kb, jb);
+                    solveLowerUnitLeft<T>(iA.getBlock(k0, k0, kb, kb), lUkj);
+                    if (k0 + kb < n)
+                        multiplyBlocks<T, RowMajor>(iA.getBlock(k0 + kb, k0, n - k0 - kb, kb), lUkj,
+                                                    iA.getBlock(k0 + kb, j0, n - k0 - kb, jb), -1, 1);
+                }, &lColonnes[k], &lColonnes[j], j == k + 1 ? 1 : 0);
+
+            for (size_t j = 0; j < k; ++j)
+                spawnTask([&, k0, kb, j]() {
+                    if (!lSinguliere.load(memory_order_relaxed))
+                        swapRows(iA.getBlock(k0, j * nb, n - k0, lLargeur(j)), &lPerm[k0], 0, kb);
+                }, &lColonnes[k], &lColonnes[j]);
+        }
+    });
+    // vérifier que la matrice n'est pas singulière
+    if (lSinguliere.load(memory_order_relaxed))
+        throw runtime_error("Matrix not invertible");
+
+    ALLOC_PHASE("eliminate");
+    BasicMatrix<T> lX(n, n);
+    parallelTasks([&]() {
+        for (size_t j = 0; j < nt; ++j)
+            spawnTask([&, j]() {
+                size_t j0 = j * nb, jb = lLargeur(j);
+                BasicBlockView<T> lXj = lX.getBlock(0, j0, n, jb);
+                for (size_t c = 0; c < jb; ++c)
+                    lXj(j0 + c, c) = 1;
+                // L Z = I, à partir du bloc j
+                for (size_t i = j; i < nt; ++i)
+                {
+                    size_t i0 = i * nb, ib = lLargeur(i);
+                    BasicBlockView<T> lZi = lXj.getBlock(i0, 0, ib, jb);
+                    if (i > j)
+                        multiplyBlocks<T, RowMajor>(iA.getBlock(i0, j0, ib, i0 - j0), lXj.getBlock(j0, 0, i0 - j0, jb),
+                                                    lZi, -1, 1);
+                    solveLowerUnitLeft<T>(iA.getBlock(i0, i0, ib, ib), lZi);
+                }
+                // U X = Z
+                for (size_t i = nt; i-- > 0;)
+                {
+                    size_t i0 = i * nb, ib = lLargeur(i);
+                    BasicBlockView<T> lXi = lXj.getBlock(i0, 0, ib, jb);
+                    if (i0 + ib < n)
+                        multiplyBlocks<T, RowMajor>(iA.getBlock(i0, i0 + ib, ib, n - i0 - ib),
+                                                    lXj.getBlock(i0 + ib, 0, n - i0 - ib, jb), lXi, -1, 1);
+                    solveUpperLeft<T>(iA.getBlock(i0, i0, ib, ib), lXi);
+                }
+            }, NULL, &lSolutions[j]);
+    });
+
+    // inv(A) = X P : défaire les échanges sur les colonnes, du dernier au premier
+    parallelFor(0, n, [&](size_t i) {
+        BasicRowView<T> lRangee = lX.getRow(i);
+        for (size_t j = n; j-- > 0;)
+        {
+            size_t p = j / nb * nb + lPerm[j];
+            if (p != j)
+                std::swap(lRangee[j], lRangee[p]);
+        }
+        iA.getRow(i) = lRangee;
+    }, n);
+}
+
+// Inverser la matrice par tuiles et graphe de tâches, par rangées.
+template <typename T>
+void invertTiled(BasicMatrix<T, RowMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    invertTiledRows(iA.getBlock());
+}
+
+// Par colonnes : inverser A^T sur place, par rangées, comme pour invertSequential.
+template <typename T>
+void invertTiled(BasicMatrix<T, ColMajor> &iA)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    invertTiledRows(iA.getBlock().transpose());
+}
+
+// oR = I - iA * iX; retourner ||oR||inf.
+static double residual(const Matrix &iA, const Matrix &iX, Matrix &oR)
+{
+    for (size_t i = 0; i < oR.rows(); ++i)
+    {
+        RowView lRow = oR.getRow(i);
+        fill(lRow.begin(), lRow.end(), 0.0);
+        lRow[i] = 1.0;
+    }
+    multiplyBlocks(iA.getBlock(), iX.getBlock(), oR.getBlock(), -1.0, 1.0);
+    return normInf(oR);
+}
+
+// oB = inv(A) oB à partir de la factorisation P A = L U de factorLU (à la getrs) :
+// échanges de rangées, puis L^-1 et U^-1 par substitution, O(n^2) par colonne de oB.
+template <typename T>
+static void solveFromLU(const BasicBlockView<const T> &iLU, const vector<size_t> &iPerm, const BasicBlockView<T> &oB)
+{
+    swapRows(oB, iPerm.data(), 0, iPerm.size());
+    solveLowerUnitLeft<T>(iLU, oB);
+    solveUpperLeft<T>(iLU, oB);
+}
+
+// Inverser la matrice en précision mixte : LU par blocs en float, raffinement en double.
+int invertMixed(Matrix &iA, double iTolerance, int iMaxIterations)
+{
+    // vérifier que la matrice est carrée
+    assert(iA.rows() == iA.cols());
+    size_t n = iA.rows();
+
+    // factorisation P A = L U en simple précision, gardée pour le raffinement, et inverse
+    // approchée X0 tirée d'une copie; un pivot nul en float ne prouve pas que la matrice
+    // est singulière : l'inversion en double tranchera
+    MatrixF lLU(n, n);
+    lLU.getBlock() = iA.getBlock();
+    vector<size_t> lPerm(n);
+    try
+    {
+        factorLU(lLU.getBlock(), lPerm);
+    }
+    catch (const runtime_error &)
+    {
+        invertLU(iA);
+        return -1;
+    }
+    MatrixF lCorrection(lLU);
+    invertFromLU(lCorrection.getBlock(), lPerm);
+    Matrix lX(n, n), lR(n, n);
+    lX.getBlock() = lCorrection.getBlock();
+
+    double lTolerance = iTolerance;
+    if (lTolerance <= 0)
+        lTolerance = n * numeric_limits<double>::epsilon() * normInf(iA) * normInf(lX);
+
+    // raffinement itératif : R(k) = I - A X(k) en double, puis X(k+1) = X(k) + D(k) avec
+    // A D(k) = R(k) résolu en float par les facteurs L U. L'erreur est multipliée à chaque
+    // pas par environ cond(A) epsilon(float); le résidu de chaque pas est recalculé
+    ALLOC_PHASE("refine");
+    double lResidual = residual(iA, lX, lR);
+    int lIterations = 0;
+    while (lResidual > lTolerance && lIterations < iMaxIterations)
+    {
+        lCorrection.getBlock() = lR.getBlock();
+        solveFromLU<float>(lLU.getBlock(), lPerm, lCorrection.getBlock());
+        parallelFor(0, n, [&](size_t i) {
+            RowView lRangee = lX.getRow(i);
+            MatrixF::RowView lDelta = lCorrection.getRow(i);
+            for (size_t j = 0; j < n; ++j)
+                lRangee[j] += lDelta[j];
+        }, n);
+        ++lIterations;
+        double lPrevious = lResidual;
+        lResidual = residual(iA, lX, lR);
+        // le résidu stagne : le float ne suffit pas pour cette matrice
+        if (lResidual > lPrevious / 2)
+            break;
+    }
+
+    // pas de convergence : tout refaire en double
+    if (lResidual > lTolerance)
+    {
+        invertLU(iA);
+        return -1;
+    }
+    iA = std::move(lX);
+    return lIterations;
+}
+
+// Instanciations compilées dans la bibliothèque.
+template void invertSequential<double>(BasicMatrix<double, RowMajor> &iA);
+template void invertSequential<float>(BasicMatrix<float, RowMajor> &iA);
+template void invertSequential<double>(BasicMatrix<double, ColMajor> &iA);
+template void invertSequential<float>(BasicMatrix<float, ColMajor> &iA);
+template void invertInPlace<double>(BasicMatrix<double, RowMajor> &iA);
+template void invertInPlace<float>(BasicMatrix<float, RowMajor> &iA);
+template void invertInPlace<double>(BasicMatrix<double, ColMajor> &iA);
+template void invertInPlace<float>(BasicMatrix<float, ColMajor> &iA);
+template void invertThreaded<double>(BasicMatrix<double, RowMajor> &iA);
+template void invertThreaded<float>(BasicMatrix<float, RowMajor> &iA);
+template void invertThreaded<double>(BasicMatrix<double, ColMajor> &iA);
+template void invertThreaded<float>(BasicMatrix<float, ColMajor> &iA);
+template void invertTiled<double>(BasicMatrix<double, RowMajor> &iA);
+template void invertTiled<float>(BasicMatrix<float, RowMajor> &iA);
+template void invertTiled<double>(BasicMatrix<double, ColMajor> &iA);
+template void invertTiled<float>(BasicMatrix<float, ColMajor> &iA);
+template void invertLU<double>(BasicMatrix<double, RowMajor> &iA);
+template void invertLU<float>(BasicMatrix<float, RowMajor> &iA);
+template void invertLU<double>(BasicMatrix<double, ColMajor> &iA);
+template void invertLU<float>(BasicMatrix<float, ColMajor> &iA);
@@ -0,0 +1,86 @@
+//
+//  Invert.hpp
+//
+
+#ifndef __INVERT_HPP__
+#define __INVERT_HPP__
+
+#include "Matrix.hpp"
+
+// Inversions séquentielles (les boucles sont réparties entre les threads de la
+// bibliothèque, Parallel.hpp). Toutes lèvent runtime_error("Matrix not invertible")
+// si un pivot est nul.
+
+// Largeur des blocs de colonnes de l'inversion par LU : le panneau factorisé rangée par
+// rangée tient dans L2, le reste passe par GEMM.
+#define INVERT_LU_BLOCK 64
+
+// Largeur des tuiles (blocs de colonnes) de l'inversion par graphe de tâches.
+#define INVERT_TILE 256
+
+// Précision mixte : au plus INVERT_MIXED_MAX_ITERATIONS pas de raffinement.
+#define INVERT_MIXED_MAX_ITERATIONS 10
+
+// Inverser la matrice par la méthode de Gauss-Jordan sur [A I].
+// Compilé pour double et float, par rangées et par colonnes.
+template <typename T>
+void invertSequential(BasicMatrix<T, RowMajor> &iA);
+
+template <typename T>
+void invertSequential(BasicMatrix<T, ColMajor> &iA);
+
+// Inverser la matrice sur place par Gauss-Jordan, sans la matrice de travail [A I] :
+// deux fois moins de mémoire et n^3 opérations au lieu de 2n^3 (les pivots échangés
+// sont notés dans un vecteur de permutation). Mêmes instanciations.
+template <typename T>
+void invertInPlace(BasicMatrix<T, RowMajor> &iA);
+
+template <typename T>
+void invertInPlace(BasicMatrix<T, ColMajor> &iA);
+
+// Inverser la matrice sur place par Gauss-Jordan réparti entre les threads de la
+// bibliothèque (Parallel.hpp, MATRIX_THREADS) : chaque thread élimine une tranche fixe de
+// rangées et cherche le pivot suivant dans sa tranche, avec une seule barrière par pivot
+// dans une région parallèle unique. Pas d'échange de rangées pendant l'élimination : la
+// permutation est appliquée à la fin (copie de la matrice). Mêmes instanciations.
+template <typename T>
+void invertThreaded(BasicMatrix<T, RowMajor> &iA);
+
+template <typename T>
+void invertThreaded(BasicMatrix<T, ColMajor> &iA);
+
+// Inverser la matrice par factorisation LU par blocs avec pivot partiel, puis inversion
+// de U et résolution de inv(A) L = inv(U) (comme getrf/getri de LAPACK), sur place.
+// 2n^3 opérations comme Gauss-Jordan, mais presque toutes dans le produit matriciel par
+// blocs (Gemm.hpp), limité par le calcul plutôt que par la mémoire. Mêmes instanciations.
+template <typename T>
+void invertLU(BasicMatrix<T, RowMajor> &iA);
+
+template <typename T>
+void invertLU(BasicMatrix<T, ColMajor> &iA);
+
+// Inverser la matrice sur place par LU en tuiles de INVERT_TILE colonnes, comme invertLU,
+// mais découpée en tâches avec dépendances explicites (Parallel.hpp) : factorisation des
+// panneaux, mises à jour et résolutions triangulaires s'exécutent dès que leurs données
+// sont prêtes, le panneau suivant en priorité, pour occuper tous les threads sur le
+// chemin critique aux grandes tailles. Demande une matrice n x n de travail.
+template <typename T>
+void invertTiled(BasicMatrix<T, RowMajor> &iA);
+
+template <typename T>
+void invertTiled(BasicMatrix<T, ColMajor> &iA);
+
+// Inverser la matrice en précision mixte : factorisation LU par blocs en float, inverse
+// approchée tirée de ces facteurs, puis raffinement itératif : R = I - A X en double
+// (GEMM), correction D solution de A D = R par les facteurs float (substitutions,
+// O(n^2) par colonne), X <- X + D, jusqu'à ||I - A X||inf <= iTolerance.
+// iTolerance <= 0 : n * epsilon(double) * ||A||inf * ||X||inf, le résidu d'une inversion
+// stable en double. Si le résidu ne diminue plus (matrice mal conditionnée pour le
+// float), l'inversion est refaite entièrement en double par invertLU.
+// Ce n'est pas un mode rapide : chaque pas vérifie le résidu par un produit n^3 en
+// double, et l'ensemble coûte plus qu'invertLU en double (bench_invert). Il sert à
+// obtenir une inverse de précision double à partir de facteurs float.
+// Retourne le nombre de pas de raffinement, ou -1 si l'inversion a été refaite en double.
+int invertMixed(Matrix &iA, double iTolerance = 0, int iMaxIterations = INVERT_MIXED_MAX_ITERATIONS);
+
+#endif
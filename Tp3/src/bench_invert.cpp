@@ -0,0 +1,115 @@
+//
+//  bench_invert.cpp
+//
+
+// Comparer les inversions en mémoire partagée (Invert.hpp), précision mixte comprise :
+// temps (meilleur de plusieurs essais), GFLOP/s (2n^3 opérations) et résidu
+// ||A X - I||inf pour chaque taille.
+//
+// Usage : bench_invert [-r essais] [n ...]
+
+#include "Matrix.hpp"
+#include "Invert.hpp"
+#include "Parallel.hpp"
+#include "Verify.hpp"
+#include "Chrono.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Une méthode d'inversion du banc d'essai.
+struct Methode
+{
+    string mNom;
+    void (*mInverse)(Matrix &);
+};
+
+static void parGaussJordan(Matrix &ioA) { invertSequential(ioA); }
+static void parGaussJordanSurPlace(Matrix &ioA) { invertInPlace(ioA); }
+static void parGaussJordanThreads(Matrix &ioA) { invertThreaded(ioA); }
+static void parLU(Matrix &ioA) { invertLU(ioA); }
+static void parTaches(Matrix &ioA) { invertTiled(ioA); }
+static void parMixte(Matrix &ioA) { invertMixed(ioA); }
+
+// Meilleur temps de iEssais inversions d'une copie de iA; oInv reçoit la dernière.
+static double bestTime(const Methode &iMethode, const Matrix &iA, int iEssais, Matrix &oInv)
+{
+    double lMeilleur = 0;
+    for (int e = 0; e < iEssais; ++e)
+    {
+        oInv = iA;
+        Chrono lChrono;
+        iMethode.mInverse(oInv);
+        double lTemps = lChrono.get();
+        if (e == 0 || lTemps < lMeilleur)
+            lMeilleur = lTemps;
+    }
+    return lMeilleur;
+}
+
+int main(int argc, char **argv)
+{
+    int lEssais = 3;
+    vector<size_t> lTailles;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            lEssais = atoi(argv[++i]);
+        else if (atoi(argv[i]) > 0)
+            lTailles.push_back(atoi(argv[i]));
+        else
+        {
+            cerr << "Usage : " << argv[0] << " [-r essais] [n ...]" << endl;
+            return 1;
+        }
+    }
+    if (lTailles.empty())
+    {
+        lTailles.push_back(500);
+        lTailles.push_back(1000);
+        lTailles.push_back(2000);
+    }
+    if (lEssais < 1)
+        lEssais = 1;
+
+    const Methode lMethodes[] = {
+        {"Gauss-Jordan", parGaussJordan},
+        {"sur place", parGaussJordanSurPlace},
+        {"multithread", parGaussJordanThreads},
+        {"LU par blocs", parLU},
+        {"LU en tuiles", parTaches},
+        {"precision mixte", parMixte},
+    };
+
+    srand((unsigned)time(NULL));
+    cout << getMatrixThreads() << " thread(s), meilleur de " << lEssais << " essai(s)" << endl;
+    cout << setw(6) << "n" << setw(16) << "methode" << setw(12) << "temps (s)" << setw(10) << "GFLOP/s"
+         << setw(10) << "gain" << setw(14) << "residu" << endl;
+
+    for (size_t t = 0; t < lTailles.size(); ++t)
+    {
+        size_t n = lTailles[t];
+        MatrixRandom lA(n, n);
+        Matrix lInv(n, n);
+        double lReference = 0;
+        for (const Methode &lMethode : lMethodes)
+        {
+            double lTemps = bestTime(lMethode, lA, lEssais, lInv);
+            // gain par rapport à Gauss-Jordan (première méthode)
+            if (lReference == 0)
+                lReference = lTemps;
+            cout << setw(6) << n << setw(16) << lMethode.mNom << setw(12) << fixed << setprecision(4) << lTemps
+                 << setw(10) << setprecision(2) << 2.0 * n * n * n / lTemps * 1e-9 << setw(9) << setprecision(1)
+                 << 100.0 * (lReference - lTemps) / lReference << "%" << setw(14) << scientific
+                 << setprecision(2) << residualInverse<double, RowMajor>(lA, lInv) << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+//
+//  bench_strassen.cpp
+//
+
+// Comparer Strassen-Winograd au produit classique (Gemm.hpp) : temps (meilleur de
+// plusieurs essais) et écart entre les deux résultats pour chaque taille demandée.
+//
+// Usage : bench_strassen [-c seuil] [-r essais] [n ...]
+
+#include "Matrix.hpp"
+#include "Gemm.hpp"
+#include "Strassen.hpp"
+#include "Parallel.hpp"
+#include "Chrono.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// Meilleur temps de iEssais appels à iProduit(iA, iB).
+template <typename F>
+static double bestTime(const F &iProduit, const Matrix &iA, const Matrix &iB, int iEssais, Matrix &oRes)
+{
+    double lMeilleur = 0;
+    for (int e = 0; e < iEssais; ++e)
+    {
+        Chrono lChrono;
+        oRes = iProduit(iA, iB);
+        double lTemps = lChrono.get();
+        if (e == 0 || lTemps < lMeilleur)
+            lMeilleur = lTemps;
+    }
+    return lMeilleur;
+}
+
+int main(int argc, char **argv)
+{
+    size_t lSeuil = STRASSEN_CUTOFF;
+    int lEssais = 3;
+    vector<size_t> lTailles;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            lSeuil = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            lEssais = atoi(argv[++i]);
+        else if (atoi(argv[i]) > 0)
+            lTailles.push_back(atoi(argv[i]));
+        else
+        {
+            cerr << "Usage : " << argv[0] << " [-c seuil] [-r essais] [n ...]" << endl;
+            return 1;
+        }
+    }
+    if (lTailles.empty())
+    {
+        lTailles.push_back(1024);
+        lTailles.push_back(2048);
+        lTailles.push_back(4096);
+    }
+    if (lEssais < 1)
+        lEssais = 1;
+
+    srand((unsigned)time(NULL));
+    cout << "Seuil " << lSeuil << ", " << getMatrixThreads() << " thread(s), meilleur de " << lEssais
+         << " essai(s)" << endl;
+    cout << setw(6) << "n" << setw(14) << "classique (s)" << setw(14) << "Strassen (s)" << setw(10) << "gain"
+         << setw(14) << "ecart max" << setw(14) << "ecart rel." << endl;
+
+    for (size_t t = 0; t < lTailles.size(); ++t)
+    {
+        size_t n = lTailles[t];
+        MatrixRandom lA(n, n), lB(n, n);
+        Matrix lClassique(n, n), lStrassen(n, n);
+
+        double lTempsClassique = bestTime([](const Matrix &iA, const Matrix &iB) {
+            return multiplyMatrix(iA, iB);
+        }, lA, lB, lEssais, lClassique);
+        double lTempsStrassen = bestTime([lSeuil](const Matrix &iA, const Matrix &iB) {
+            return multiplyMatrixStrassen(iA, iB, lSeuil);
+        }, lA, lB, lEssais, lStrassen);
+
+        // écart élément par élément, et relatif en norme de Frobenius
+        double lEcartMax = 0, lEcart2 = 0, lNorme2 = 0;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                double lD = lStrassen(i, j) - lClassique(i, j);
+                lEcartMax = max(lEcartMax, fabs(lD));
+                lEcart2 += lD * lD;
+                lNorme2 += lClassique(i, j) * lClassique(i, j);
+            }
+
+        cout << setw(6) << n << setw(14) << fixed << setprecision(4) << lTempsClassique << setw(14)
+             << lTempsStrassen << setw(9) << setprecision(1)
+             << 100.0 * (lTempsClassique - lTempsStrassen) / lTempsClassique << "%" << setw(14) << scientific
+             << setprecision(2) << lEcartMax << setw(14) << sqrt(lEcart2 / lNorme2) << endl;
+    }
+    return 0;
+}
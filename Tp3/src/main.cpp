@@ -3,79 +3,25 @@
 //
 
 #include "Matrix.hpp"
+#include "Invert.hpp"
+#include "Parallel.hpp"
+#include "Verify.hpp"
+#include "MatrixFile.hpp"
+#include "MatrixText.hpp"
 #include "mpi.h"
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <memory>
 #include <vector>
 #include <iostream>
 #include <stdexcept>
 #include <mpi.h>
 #include "Chrono.hpp" // Classe chronomètre pour le temps d'éxécution
+#include "AllocProfile.hpp"
 
 using namespace std;
 
-// Inverser la matrice par la méthode de Gauss-Jordan; implantation séquentielle.
-void invertSequential(Matrix &iA)
-{
-
-    // vérifier que la matrice est carrée
-    assert(iA.rows() == iA.cols());
-    // construire la matrice [A I]
-    MatrixConcatCols lAI(iA, MatrixIdentity(iA.rows()));
-
-    // traiter chaque rangée
-    for (size_t k = 0; k < iA.rows(); ++k)
-    {
-        // trouver l'index p du plus grand pivot de la colonne k en valeur absolue
-        // (pour une meilleure stabilité numérique).
-        size_t p = k;
-        double lMax = fabs(lAI(k, k));
-        for (size_t i = k; i < lAI.rows(); ++i)
-        {
-            if (fabs(lAI(i, k)) > lMax)
-            {
-                lMax = fabs(lAI(i, k));
-                p = i;
-            }
-        }
-        // vérifier que la matrice n'est pas singulière
-        if (lAI(p, k) == 0)
-            throw runtime_error("Matrix not invertible");
-
-        // échanger la ligne courante avec celle du pivot
-        if (p != k)
-            lAI.swapRows(p, k);
-
-        double lValue = lAI(k, k);
-        for (size_t j = 0; j < lAI.cols(); ++j)
-        {
-            // On divise les éléments de la rangée k
-            // par la valeur du pivot.
-            // Ainsi, lAI(k,k) deviendra égal à 1.
-            lAI(k, j) /= lValue;
-        }
-
-        // Pour chaque rangée...
-        for (size_t i = 0; i < lAI.rows(); ++i)
-        {
-            if (i != k)
-            { // ...différente de k
-                // On soustrait la rangée k
-                // multipliée par l'élément k de la rangée courante
-                double lValue = lAI(i, k);
-                lAI.getRowSlice(i) -= lAI.getRowCopy(k) * lValue;
-            }
-        }
-    }
-
-    // On copie la partie droite de la matrice AI ainsi transformée
-    // dans la matrice courante (this).
-    for (unsigned int i = 0; i < iA.rows(); ++i)
-    {
-        iA.getRowSlice(i) = lAI.getDataArray()[slice(i * lAI.cols() + iA.cols(), iA.cols(), 1)];
-    }
-}
-
 // Inverser la matrice par la méthode de Gauss-Jordan; implantation MPI parallèle.
 void invertParallel(Matrix &matrice)
 {
@@ -87,6 +33,9 @@ void invertParallel(Matrix &matrice)
     // Rang du processus
     int world_rank;
     MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    // Plusieurs rangs sur une même machine : la bibliothèque Matrix reste séquentielle dans chacun
+    if (world_size > 1)
+        setMatrixThreads(1);
 
     // Vérifier que la matrice est carrée
     assert(matrice.rows() == matrice.cols());
@@ -96,6 +45,7 @@ void invertParallel(Matrix &matrice)
     // Debut de l'algorithme
     for (size_t idx_ligne = 0; idx_ligne < matrice.rows(); ++idx_ligne)
     {
+        ALLOC_PHASE("pivot");
         // Répartit les indices des lignes dans les processeurs grâce à un map (dictionnaire)
         map<double, int> dic_Values_col;
         for (size_t idx_ligne_rest = idx_ligne; idx_ligne_rest < matrice.rows(); ++idx_ligne_rest)
@@ -168,6 +118,7 @@ void invertParallel(Matrix &matrice)
         MPI::COMM_WORLD.Bcast((void *)&ligne_pivot_broadcast[0], ligne_pivot_broadcast.size(), MPI_DOUBLE, idx_ligne % world_size);
 
         // Fait les opérations de gauss sur les lignes
+        ALLOC_PHASE("eliminate");
         for (size_t idx_ligne_rest = 0; idx_ligne_rest < matrice_et_id.rows(); idx_ligne_rest++)
         {
             if (((idx_ligne_rest % world_size) == world_rank) && (idx_ligne_rest != idx_ligne))
@@ -189,30 +140,50 @@ void invertParallel(Matrix &matrice)
     }
     MPI::Finalize();
     // On copie la partie droite de la matrice [ A I ] qui est devenue [I A^-1] ainsi transformée dans la matrice courante.
-    for (size_t i = 0; i < matrice_et_id.rows(); ++i)
-    {
-        matrice.getRowSlice(i) = matrice_et_id.getDataArray()[slice(i * matrice_et_id.cols() + matrice.cols(), matrice.cols(), 1)];
-    }
+    matrice.getBlock() = matrice_et_id.getBlock(0, matrice.cols(), matrice.rows(), matrice.cols());
 }
 
-// Multiplier deux matrices.
-Matrix multiplyMatrix(const Matrix &iMat1, const Matrix &iMat2)
+// Vérifier l'inverse (Verify.hpp) et afficher le résidu ||A X - I||inf, estimé par
+// Freivalds sur essais vecteurs aléatoires (exact si essais <= 0).
+template <typename T, typename Layout>
+void printVerification(const string &nom, const BasicMatrix<T, Layout> &matrice, const BasicMatrix<T, Layout> &inverse,
+                       int essais)
 {
+    double residu;
+    bool ok = verifyInverse(matrice, inverse, essais, residu);
+    cout << "Erreur " << nom << ": " << residu << (ok ? "" : " (au-dessus de la tolerance)") << endl
+         << endl;
+}
 
-    // vérifier la compatibilité des matrices
-    assert(iMat1.cols() == iMat2.rows());
-    // effectuer le produit matriciel
-    Matrix lRes(iMat1.rows(), iMat2.cols());
-    // traiter chaque rangée
-    for (size_t i = 0; i < lRes.rows(); ++i)
-    {
-        // traiter chaque colonne
-        for (size_t j = 0; j < lRes.cols(); ++j)
-        {
-            lRes(i, j) = (iMat1.getRowCopy(i) * iMat2.getColumnCopy(j)).sum();
-        }
-    }
-    return lRes;
+// Algorithme séquentiel sur une copie de la matrice dans l'instanciation <T, Layout>,
+// inversée par inverse(matrice); l'inverse est écrite dans le fichier sortie s'il est donné.
+template <typename T, typename Layout, typename F>
+void runSequential(const ConstBlockView &matrice, Chrono &chron, int essais, const string &sortie, const F &inverse)
+{
+    BasicMatrix<T, Layout> mat_Seq(matrice.rows(), matrice.cols());
+    mat_Seq.getBlock() = matrice;
+    BasicMatrix<T, Layout> mat_Inv_Seq(mat_Seq);
+    float tic_seq = chron.get();
+    inverse(mat_Inv_Seq);
+    float tac_seq = chron.get();
+    // cout << "Matrice inverse sequentielle:\n"
+    //      << mat_Inv_Seq.str() << endl
+    //      << endl;
+
+    ALLOC_PHASE("multiply");
+    printVerification("sequentielle", mat_Seq, mat_Inv_Seq, essais);
+    cout << "Temps sequentiel : " << tac_seq - tic_seq << "secondes" << endl;
+    if (!sortie.empty() && isTextMatrixPath(sortie))
+        writeMatrixText(sortie, mat_Inv_Seq);
+    else if (!sortie.empty())
+        writeMatrix(sortie, mat_Inv_Seq);
+}
+
+// Syntaxe de la ligne de commande et noms des variantes séquentielles.
+void printUsage(const char *programme)
+{
+    cerr << "Usage : " << programme << " [-i entree] [-o sortie] taille [variante] [essais]" << endl
+         << "  variante : double, float, col, float-col, mixed, inplace, threaded, lu, tiled" << endl;
 }
 
 int main(int argc, char **argv)
@@ -220,33 +191,113 @@ int main(int argc, char **argv)
 
     srand((unsigned)time(NULL));
 
+    // [-i entrée] [-o sortie] taille variante essais : -i lit la matrice dans un fichier
+    // binaire (MatrixFile.hpp, double par rangées) ou texte (.csv ou .mtx, MatrixText.hpp)
+    // au lieu d'une matrice aléatoire, la taille est alors omise; -o écrit l'inverse
+    // séquentielle dans un fichier binaire ou texte selon l'extension.
+    // Variante de l'algorithme séquentiel : double (défaut), float, col ou float-col
+    // (éléments rangés par colonnes), mixed (LU en float raffiné en double), inplace (sans la
+    // matrice [A I]), threaded (Gauss-Jordan multithread, MATRIX_THREADS), lu
+    // (factorisation LU par blocs), tiled (LU en tuiles, graphe de tâches); enfin le
+    // nombre de vecteurs de la vérification de Freivalds (0 : résidu exact)
     unsigned int taille_mat = 5;
-    if (argc == 2)
+    string type_seq = "double";
+    int essais = VERIFY_TRIALS;
+    string entree, sortie;
+    vector<string> arguments;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+            entree = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            sortie = argv[++i];
+        else
+            arguments.push_back(argv[i]);
+    }
+    size_t suivant = 0;
+    if (entree.empty() && suivant < arguments.size())
     {
-        taille_mat = atoi(argv[1]);
+        taille_mat = atoi(arguments[suivant++].c_str());
+    }
+    if (suivant < arguments.size())
+    {
+        type_seq = arguments[suivant++];
+    }
+    if (suivant < arguments.size())
+    {
+        essais = atoi(arguments[suivant++].c_str());
+    }
+    if (suivant < arguments.size())
+    {
+        cerr << "Argument inattendu : " << arguments[suivant] << endl;
+        printUsage(argv[0]);
+        return 1;
     }
 
-    MatrixRandom matrice(taille_mat, taille_mat);
+    // matrice du fichier binaire, projetée en mémoire sans copie, du fichier texte, lue en
+    // parallèle, ou aléatoire
+    unique_ptr<MappedMatrix> fichier;
+    unique_ptr<Matrix> texte;
+    if (!entree.empty())
+    {
+        try
+        {
+            if (isTextMatrixPath(entree))
+                texte.reset(new Matrix(readMatrixText<double, RowMajor>(entree)));
+            else
+                fichier.reset(new MappedMatrix(entree));
+        }
+        catch (const exception &e)
+        {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        ConstBlockView lue = texte ? texte->getBlock() : fichier->getBlock();
+        taille_mat = lue.rows();
+        if (lue.cols() != taille_mat)
+        {
+            cerr << "Matrice non carree : " << entree << endl;
+            return 1;
+        }
+    }
+    MatrixRandom aleatoire(entree.empty() ? taille_mat : 0, entree.empty() ? taille_mat : 0);
+    ConstBlockView matrice = texte ? texte->getBlock() : fichier ? fichier->getBlock() : aleatoire.getBlock();
     Chrono chron = Chrono();
     // Algorithme sequentiel
-    Matrix mat_Inv_Seq(matrice);
-    float tic_seq = chron.get();
-    invertSequential(mat_Inv_Seq);
-    float tac_seq = chron.get();
-    // cout << "Matrice inverse sequentielle:\n"
-    //      << mat_Inv_Seq.str() << endl
-    //      << endl;
-
-    Matrix res_Seq = multiplyMatrix(matrice, mat_Inv_Seq);
-    // cout << "Produit des deux matrices sequentielle:\n"
-    //      << res_Seq.str() << endl
-    //      << endl;
-
-    cout << "Erreur sequentielle: " << res_Seq.getDataArray().sum() - taille_mat << endl
-         << endl;
-    cout << "Temps sequentiel : " << tac_seq - tic_seq << "secondes" << endl;
+    if (type_seq == "float")
+        runSequential<float, RowMajor>(matrice, chron, essais, sortie, [](MatrixF &m) { invertSequential(m); });
+    else if (type_seq == "col")
+        runSequential<double, ColMajor>(matrice, chron, essais, sortie, [](MatrixCol &m) { invertSequential(m); });
+    else if (type_seq == "float-col")
+        runSequential<float, ColMajor>(matrice, chron, essais, sortie, [](MatrixFCol &m) { invertSequential(m); });
+    else if (type_seq == "mixed")
+        runSequential<double, RowMajor>(matrice, chron, essais, sortie, [](Matrix &m) {
+            int pas = invertMixed(m);
+            if (pas < 0)
+                cout << "Precision mixte : raffinement sans convergence, inversion refaite en double" << endl;
+            else
+                cout << "Precision mixte : " << pas << " pas de raffinement" << endl;
+        });
+    else if (type_seq == "inplace")
+        runSequential<double, RowMajor>(matrice, chron, essais, sortie, [](Matrix &m) { invertInPlace(m); });
+    else if (type_seq == "threaded")
+        runSequential<double, RowMajor>(matrice, chron, essais, sortie, [](Matrix &m) { invertThreaded(m); });
+    else if (type_seq == "lu")
+        runSequential<double, RowMajor>(matrice, chron, essais, sortie, [](Matrix &m) { invertLU(m); });
+    else if (type_seq == "tiled")
+        runSequential<double, RowMajor>(matrice, chron, essais, sortie, [](Matrix &m) { invertTiled(m); });
+    else if (type_seq == "double")
+        runSequential<double, RowMajor>(matrice, chron, essais, sortie, [](Matrix &m) { invertSequential(m); });
+    else
+    {
+        cerr << "Variante inconnue : " << type_seq << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
     //Algorithme parallele
-    Matrix mat_Inv_Par(matrice);
+    Matrix mat_Par(taille_mat, taille_mat);
+    mat_Par.getBlock() = matrice;
+    Matrix mat_Inv_Par(mat_Par);
     float tic_par = chron.get();
     invertParallel(mat_Inv_Par);
     float tac_par = chron.get();
@@ -254,13 +305,8 @@ int main(int argc, char **argv)
     //      << mat_Inv_Par.str() << endl
     //      << endl;
 
-    Matrix res_Par = multiplyMatrix(matrice, mat_Inv_Par);
-    // cout << "Produit des deux matrices parallele:\n"
-    //      << res_Par.str() << endl
-    //      << endl;
-
+    ALLOC_PHASE("multiply");
     cout << "Temps parallele : " << tac_par - tic_par << "secondes" << endl;
-    cout << "Erreur parallèle: " << res_Par.getDataArray().sum() - taille_mat << endl
-         << endl;
+    printVerification("parallèle", mat_Par, mat_Inv_Par, essais);
     return 0;
 }
@@ -0,0 +1,74 @@
+//
+//  compare_matrix.cpp
+//
+
+// Comparer deux matrices lues en binaire (MatrixFile.hpp) ou en texte (.csv ou .mtx,
+// MatrixText.hpp) : mêmes dimensions et |a - b| <= tolérance * (1 + |a|) pour chaque
+// élément. Sert aux tests d'aller-retour -i/-o du Tp3 (CMakeLists.txt).
+//
+// Usage : compare_matrix attendue obtenue [tolérance]
+
+#include "Matrix.hpp"
+#include "MatrixFile.hpp"
+#include "MatrixText.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// Matrice d'un fichier texte, copiée, ou binaire, projetée en mémoire.
+struct MatrixSource
+{
+    unique_ptr<Matrix> texte;
+    unique_ptr<MappedMatrix> fichier;
+
+    explicit MatrixSource(const string &iPath)
+    {
+        if (isTextMatrixPath(iPath))
+            texte.reset(new Matrix(readMatrixText<double, RowMajor>(iPath)));
+        else
+            fichier.reset(new MappedMatrix(iPath));
+    }
+
+    ConstBlockView getBlock(void) const { return texte ? texte->getBlock() : fichier->getBlock(); }
+};
+
+int main(int argc, char **argv)
+{
+    if (argc < 3 || argc > 4)
+    {
+        cerr << "Usage : " << argv[0] << " attendue obtenue [tolerance]" << endl;
+        return 1;
+    }
+    double tolerance = (argc == 4) ? atof(argv[3]) : 1e-9;
+
+    try
+    {
+        MatrixSource attendue(argv[1]), obtenue(argv[2]);
+        ConstBlockView a = attendue.getBlock(), b = obtenue.getBlock();
+        if (a.rows() != b.rows() || a.cols() != b.cols())
+        {
+            cerr << "Dimensions differentes : " << a.rows() << "x" << a.cols() << " et "
+                 << b.rows() << "x" << b.cols() << endl;
+            return 1;
+        }
+        for (size_t i = 0; i < a.rows(); ++i)
+            for (size_t j = 0; j < a.cols(); ++j)
+                if (!(fabs(a(i, j) - b(i, j)) <= tolerance * (1 + fabs(a(i, j)))))
+                {
+                    cerr << "Element (" << i << ", " << j << ") : " << a(i, j) << " au lieu de "
+                         << b(i, j) << endl;
+                    return 1;
+                }
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -8,33 +8,20 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 
 #include "Matrix.hpp"
+#include "Verify.hpp"
+#include "MatrixFile.hpp"
+#include "MatrixText.hpp"
 #include "Chrono.hpp"
 
 using namespace std;
 
-// Multiplier deux matrices.
-Matrix multiplyMatrix(const Matrix &iMat1, const Matrix &iMat2)
-{
-
-    // vérifier la compatibilité des matrices
-    assert(iMat1.cols() == iMat2.rows());
-    // effectuer le produit matriciel
-    Matrix lRes(iMat1.rows(), iMat2.cols());
-    // traiter chaque rangée
-    for (size_t i = 0; i < lRes.rows(); ++i)
-    {
-        // traiter chaque colonne
-        for (size_t j = 0; j < lRes.cols(); ++j)
-        {
-            lRes(i, j) = (iMat1.getRowCopy(i) * iMat2.getColumnCopy(j)).sum();
-        }
-    }
-    return lRes;
-}
 
 int main(int argc, char **argv)
 {
@@ -42,13 +29,70 @@ int main(int argc, char **argv)
     srand((unsigned)time(NULL));
     Chrono chron = Chrono();
 
+    // [-i entrée] [-o sortie] taille essais : -i lit la matrice dans un fichier binaire
+    // (MatrixFile.hpp, double par rangées) ou texte (.csv ou .mtx, MatrixText.hpp) au lieu
+    // d'une matrice aléatoire, la taille est alors omise; -o écrit l'inverse dans un fichier
+    // binaire ou texte selon l'extension. Enfin le nombre de
+    // vecteurs de la vérification de Freivalds (0 : résidu exact).
     unsigned int taille_mat = 5;
-    if (argc == 2)
+    int essais = VERIFY_TRIALS;
+    string entree, sortie;
+    vector<string> arguments;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+            entree = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            sortie = argv[++i];
+        else
+            arguments.push_back(argv[i]);
+    }
+    size_t suivant = 0;
+    if (entree.empty() && suivant < arguments.size())
     {
-        taille_mat = atoi(argv[1]);
+        taille_mat = atoi(arguments[suivant++].c_str());
+    }
+    if (suivant < arguments.size())
+    {
+        essais = atoi(arguments[suivant++].c_str());
+    }
+    if (suivant < arguments.size())
+    {
+        cerr << "Argument inattendu : " << arguments[suivant] << endl
+             << "Usage : " << argv[0] << " [-i entree] [-o sortie] taille [essais]" << endl;
+        return 1;
     }
 
-    MatrixRandom matrice(taille_mat, taille_mat);
+    unique_ptr<MappedMatrix> fichier;
+    unique_ptr<Matrix> texte;
+    if (!entree.empty())
+    {
+        try
+        {
+            if (isTextMatrixPath(entree))
+                texte.reset(new Matrix(readMatrixText<double, RowMajor>(entree)));
+            else
+                fichier.reset(new MappedMatrix(entree));
+        }
+        catch (const exception &e)
+        {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        taille_mat = texte ? texte->rows() : fichier->rows();
+        if ((texte ? texte->cols() : fichier->cols()) != taille_mat)
+        {
+            cerr << "Matrice non carree : " << entree << endl;
+            return 1;
+        }
+    }
+    Matrix matrice(taille_mat, taille_mat);
+    if (texte)
+        matrice.getBlock() = texte->getBlock();
+    else if (fichier)
+        matrice.getBlock() = fichier->getBlock();
+    else
+        matrice = MatrixRandom(taille_mat, taille_mat);
     MatrixIdentity matriceInverse(taille_mat);
 
     MatrixConcatCols matrice_et_id(matrice, MatrixIdentity(matrice.rows()));
@@ -180,7 +224,9 @@ int main(int argc, char **argv)
         ////////////////////////////////////////
         //   Crée le buffer pour le device    //
         ////////////////////////////////////////
-        double *buff_mat = &matrice_et_id.getDataArray()[0];
+        // copie contiguë (sans le remplissage des rangées) pour le device
+        valarray<double> mat_contigue = matrice_et_id.getDataArray();
+        double *buff_mat = &mat_contigue[0];
         int taille_cols = matrice_et_id.cols();
         int *buff_nb_cols = &taille_cols;
         int idx_line = 0;
@@ -311,19 +357,24 @@ int main(int argc, char **argv)
         // dans la matrice courante (this).
         for (unsigned int i = 0; i < matriceInverse.rows(); ++i)
         {
-            matriceInverse.getRowSlice(i) = matOut.getDataArray()[slice(i * matOut.cols() + matriceInverse.cols(), matriceInverse.cols(), 1)];
+            matriceInverse.getRowSlice(i) = matOut.getRow(i, matriceInverse.cols(), matriceInverse.cols());
         }
 
-        Matrix res = multiplyMatrix(matrice, matriceInverse);
+        double residu;
+        bool ok = verifyInverse<double, RowMajor>(matrice, matriceInverse, essais, residu);
 
         // cout << "Matrice d'entrée : " << endl
         //           << matrice_et_id << endl;
         // cout << endl;
         // cout << "Matrice de sortie : " << endl
         //           << matOut << endl;
-        cout << "Erreur : " << res.getDataArray().sum() - taille_mat << endl
+        cout << "Erreur : " << residu << (ok ? "" : " (au-dessus de la tolerance)") << endl
              << endl;
         cout << "Temps : " << tac - tic << "secondes" << endl;
+        if (!sortie.empty() && isTextMatrixPath(sortie))
+            writeMatrixText(sortie, matriceInverse);
+        else if (!sortie.empty())
+            writeMatrix(sortie, matriceInverse);
 
         // ////////////////////////////////////////
         // //       Clean les allocations  pas possible en c++      //
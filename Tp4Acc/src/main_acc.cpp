@@ -1,22 +1,29 @@
 #include "Matrix.hpp"
+#include "Verify.hpp"
+#include "MatrixFile.hpp"
+#include "MatrixText.hpp"
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 #include "Chrono.hpp" // Classe chronomètre pour le temps d'éxécution
 
 using namespace std;
 
-#define N 20000
-
-
 // Inverser la matrice par la méthode de Gauss-Jordan; implantation séquentielle.
+// Sur place, sans la matrice [A I] (deux fois moins de mémoire pour N x N) : au pas k,
+// la colonne k de A reçoit la colonne k de l'inverse, et les échanges de rangées, notés
+// dans lPerm, sont défaits à la fin sur les colonnes.
 void invertMatrix(Matrix &iA)
 {
 
     // vérifier que la matrice est carrée
     assert(iA.rows() == iA.cols());
-    // construire la matrice [A I]
-    MatrixConcatCols lAI(iA, MatrixIdentity(iA.rows()));
+    // lPerm[k] : rangée échangée avec la rangée k au pas k
+    vector<size_t> lPerm(iA.rows());
 
     // traiter chaque rangée
     for (size_t k = 0; k < iA.rows(); ++k)
@@ -24,128 +31,155 @@ void invertMatrix(Matrix &iA)
         // trouver l'index p du plus grand pivot de la colonne k en valeur absolue
         // (pour une meilleure stabilité numérique).
         size_t p = k;
-        double lMax = fabs(lAI(k, k));
-        for (size_t i = k; i < lAI.rows(); ++i)
+        double lMax = fabs(iA(k, k));
+        for (size_t i = k; i < iA.rows(); ++i)
         {
-            if (fabs(lAI(i, k)) > lMax)
+            if (fabs(iA(i, k)) > lMax)
             {
-                lMax = fabs(lAI(i, k));
+                lMax = fabs(iA(i, k));
                 p = i;
             }
         }
         // vérifier que la matrice n'est pas singulière
-        if (lAI(p, k) == 0)
+        if (iA(p, k) == 0)
             throw runtime_error("Matrix not invertible");
 
         // échanger la ligne courante avec celle du pivot
+        lPerm[k] = p;
         if (p != k)
-            lAI.swapRows(p, k);
+            iA.swapRows(p, k);
 
-        double lValue = lAI(k, k);
-        #pragma acc data //copyout(lAI, lValue)
+        double lValue = iA(k, k);
+        iA(k, k) = 1.0;
+        #pragma acc data //copyout(iA, lValue)
         {
         #pragma acc parallel loop        
-        for (size_t j = 0; j < lAI.cols(); ++j)
+        for (size_t j = 0; j < iA.cols(); ++j)
         {
             // On divise les éléments de la rangée k
             // par la valeur du pivot.
-            // Ainsi, lAI(k,k) deviendra égal à 1.
-            lAI(k, j) /= lValue;
+            // Ainsi, iA(k,k) deviendra égal à 1 / pivot.
+            iA(k, j) /= lValue;
         }
 
         // Pour chaque rangée...
         #pragma acc parallel loop 
-        for (size_t i = 0; i < lAI.rows(); ++i)
+        for (size_t i = 0; i < iA.rows(); ++i)
         {
             if (i != k)
             { // ...différente de k
                 // On soustrait la rangée k
-                // multipliée par l'élément k de la rangée courante
-                double lValue = lAI(i, k);
-                lAI.getRowSlice(i) -= lAI.getRowCopy(k) * lValue;
+                // multipliée par l'élément k de la rangée courante;
+                // la colonne k reçoit celle de l'inverse
+                double lValue = iA(i, k);
+                iA(i, k) = 0.0;
+                iA.getRow(i) -= iA.getRow(k) * lValue;
             }
         }
         }
     }
 
-    // On copie la partie droite de la matrice AI ainsi transformée
-    // dans la matrice courante (this).
-    for (unsigned int i = 0; i < iA.rows(); ++i)
-    {
-        iA.getRowSlice(i) = lAI.getDataArray()[slice(i * lAI.cols() + iA.cols(), iA.cols(), 1)];
-    }
+    // Les échanges de rangées de A sont des échanges de colonnes de l'inverse :
+    // les défaire du dernier au premier.
+    for (size_t k = iA.rows(); k-- > 0;)
+        if (lPerm[k] != k)
+            iA.swapColumns(k, lPerm[k]);
 }
 
-// Multiplier deux matrices.
-Matrix multiplyMatrix(const Matrix &iMat1, const Matrix &iMat2)
+int main(int argc, char **argv)
 {
+    srand((unsigned)time(NULL));
 
-    // vérifier la compatibilité des matrices
-    assert(iMat1.cols() == iMat2.rows());
-    // effectuer le produit matriciel
-    Matrix lRes(iMat1.rows(), iMat2.cols());
-    // traiter chaque rangée
-    for (size_t i = 0; i < lRes.rows(); ++i)
+    // [-i entrée] [-o sortie] taille essais : -i lit la matrice dans un fichier binaire
+    // (MatrixFile.hpp, double par rangées) ou texte (.csv ou .mtx, MatrixText.hpp) au lieu
+    // d'une matrice aléatoire, la taille est alors omise; -o écrit l'inverse dans un fichier
+    // binaire ou texte selon l'extension. Enfin le nombre de
+    // vecteurs de la vérification de Freivalds (0 : résidu exact).
+    unsigned int taille_mat = 5;
+    int essais = VERIFY_TRIALS;
+    string entree, sortie;
+    vector<string> arguments;
+    for (int i = 1; i < argc; ++i)
     {
-        // traiter chaque colonne
-        for (size_t j = 0; j < lRes.cols(); ++j)
-        {
-            lRes(i, j) = (iMat1.getRowCopy(i) * iMat2.getColumnCopy(j)).sum();
-        }
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+            entree = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            sortie = argv[++i];
+        else
+            arguments.push_back(argv[i]);
     }
-    return lRes;
-}
-
-void dummy_function(){
-    double a[N];
-    double b[N];
-    int i, j;
-
-    #pragma acc parallel
+    size_t suivant = 0;
+    if (entree.empty() && suivant < arguments.size())
     {
-        #pragma acc loop independent
-        for(i=0;i<N;i++){
-            a[i] = i+1;
-            b[i] = 2*i+0.1;
-        }
-
-        #pragma acc loop independent
-        for(i=0;i<N;i++){
-            for(j=0;j<N;j++){
-                a[i] += 2*a[i]/b[j]+3;
-            }
-        }
+        taille_mat = atoi(arguments[suivant++].c_str());
     }
-}
-
-
-int main(int argc, char **argv)
-{
-    srand((unsigned)time(NULL));
-
-    unsigned int taille_mat = 5;
-    if (argc == 2)
+    if (suivant < arguments.size())
+    {
+        essais = atoi(arguments[suivant++].c_str());
+    }
+    if (suivant < arguments.size())
     {
-        taille_mat = atoi(argv[1]);
+        cerr << "Argument inattendu : " << arguments[suivant] << endl
+             << "Usage : " << argv[0] << " [-i entree] [-o sortie] taille [essais]" << endl;
+        return 1;
     }
 
-    MatrixRandom matrice(taille_mat, taille_mat);
+    unique_ptr<MappedMatrix> fichier;
+    unique_ptr<Matrix> texte;
+    if (!entree.empty())
+    {
+        try
+        {
+            if (isTextMatrixPath(entree))
+                texte.reset(new Matrix(readMatrixText<double, RowMajor>(entree)));
+            else
+                fichier.reset(new MappedMatrix(entree));
+        }
+        catch (const exception &e)
+        {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        taille_mat = texte ? texte->rows() : fichier->rows();
+        if ((texte ? texte->cols() : fichier->cols()) != taille_mat)
+        {
+            cerr << "Matrice non carree : " << entree << endl;
+            return 1;
+        }
+    }
+    Matrix matrice(taille_mat, taille_mat);
+    if (texte)
+        matrice.getBlock() = texte->getBlock();
+    else if (fichier)
+        matrice.getBlock() = fichier->getBlock();
+    else
+        matrice = MatrixRandom(taille_mat, taille_mat);
     Chrono chron = Chrono();
     Matrix mat_Inv(matrice);
     float tic = chron.get();
-    //invertMatrix(mat_Inv);
-    dummy_function();
+    try
+    {
+        invertMatrix(mat_Inv);
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
     float tac = chron.get();
     // cout << "Matrice inverse sequentielle:\n"
     //      << mat_Inv.str() << endl
     //      << endl;
 
+    double residu;
+    bool ok = verifyInverse<double, RowMajor>(matrice, mat_Inv, essais, residu);
+    cout << "Erreur sequentielle : " << residu << (ok ? "" : " (au-dessus de la tolerance)") << endl
+         << endl;
     cout << "Temps sequentiel : " << tac - tic << "secondes" << endl;
-
-    // Matrix res = multiplyMatrix(matrice, mat_Inv);
-    // cout << "Erreur sequentielle: " << res.getDataArray().sum() - taille_mat << endl
-    //      << endl;
-    
+    if (!sortie.empty() && isTextMatrixPath(sortie))
+        writeMatrixText(sortie, mat_Inv);
+    else if (!sortie.empty())
+        writeMatrix(sortie, mat_Inv);
 
     // cout << "Produit des deux matrices:\n"
     //      << res.str() << endl
@@ -154,4 +188,3 @@ int main(int argc, char **argv)
     return 0;
 }
 
-